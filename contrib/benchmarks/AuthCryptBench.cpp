@@ -0,0 +1,122 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Headers per second of the world packet header cipher (AuthCrypt::EncryptSend),
+ * before and after the state of the cipher was kept in locals.
+ *
+ * Standalone, no dependency on the server sources:
+ *   g++ -O2 -std=c++14 AuthCryptBench.cpp -o authcrypt_bench && ./authcrypt_bench
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+typedef uint8_t uint8;
+
+static size_t const CRYPTED_SEND_LEN = 4;
+static size_t const HEADER_COUNT = 50 * 1000 * 1000;
+
+// AuthCrypt::EncryptSend before the change: members reloaded after every byte
+struct MemberCrypt
+{
+    std::vector<uint8> _key;
+    uint8 _send_i = 0, _send_j = 0;
+
+    void EncryptSend(uint8* data, size_t len)
+    {
+        if (len < CRYPTED_SEND_LEN) { return; }
+
+        for (size_t t = 0; t < CRYPTED_SEND_LEN; t++)
+        {
+            _send_i %= _key.size();
+            uint8 x = (data[t] ^ _key[_send_i]) + _send_j;
+            ++_send_i;
+            data[t] = _send_j = x;
+        }
+    }
+};
+
+// AuthCrypt::EncryptSend now: state in locals, compare instead of modulo
+struct LocalCrypt
+{
+    std::vector<uint8> _key;
+    uint8 _send_i = 0, _send_j = 0;
+
+    void EncryptSend(uint8* data, size_t len)
+    {
+        if (len < CRYPTED_SEND_LEN) { return; }
+
+        uint8 const* key = _key.data();
+        size_t const keySize = _key.size();
+        uint8 i = _send_i, j = _send_j;
+
+        for (size_t t = 0; t < CRYPTED_SEND_LEN; t++)
+        {
+            if (i >= keySize)
+                i = 0;
+            uint8 x = (data[t] ^ key[i]) + j;
+            ++i;
+            data[t] = j = x;
+        }
+
+        _send_i = i;
+        _send_j = j;
+    }
+};
+
+// Encrypts HEADER_COUNT headers, one call per header like MangosSocket::handle_output
+template<class Crypt>
+static uint32_t Run(char const* name, std::vector<uint8>& headers)
+{
+    Crypt crypt;
+    for (uint8 i = 0; i < 20; ++i)                          // SHA1 digest sized key
+        crypt._key.push_back(uint8(i * 37 + 11));
+
+    auto const begin = std::chrono::steady_clock::now();
+    size_t const count = headers.size() / CRYPTED_SEND_LEN;
+    for (size_t h = 0; h < HEADER_COUNT; ++h)
+        crypt.EncryptSend(&headers[(h % count) * CRYPTED_SEND_LEN], CRYPTED_SEND_LEN);
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    uint32_t checksum = 0;
+    for (uint8 byte : headers)
+        checksum = checksum * 31 + byte;
+
+    printf("%-8s %7.1f M headers/s  (checksum %08x)\n", name, HEADER_COUNT / seconds / 1e6, checksum);
+    return checksum;
+}
+
+int main()
+{
+    // Size and opcode of 4096 queued packets, reused so the data stays in the cache
+    std::vector<uint8> headers(4096 * CRYPTED_SEND_LEN);
+    for (size_t i = 0; i < headers.size(); ++i)
+        headers[i] = uint8(i * 131 + 7);
+    std::vector<uint8> copy = headers;
+
+    uint32_t const before = Run<MemberCrypt>("members", headers);
+    uint32_t const after = Run<LocalCrypt>("locals", copy);
+    if (before != after)
+    {
+        printf("outputs differ\n");
+        return 1;
+    }
+    return 0;
+}
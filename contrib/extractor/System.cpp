@@ -259,11 +259,24 @@ void ReadLiquidTypeTableDBC()
 
 // Map file format data
 static char const* MAP_MAGIC         = "MAPS";
-static char const* MAP_VERSION_MAGIC = "z1.4";
+static char const* MAP_VERSION_MAGIC = "z1.5";
 static char const* MAP_AREA_MAGIC    = "AREA";
 static char const* MAP_HEIGHT_MAGIC  = "MHGT";
 static char const* MAP_LIQUID_MAGIC  = "MLIQ";
 
+// The server uses the arrays of the file in place, each section starts aligned
+uint32 alignMapSection(uint32 offset)
+{
+    return (offset + MAP_SECTION_ALIGNMENT - 1) & ~uint32(MAP_SECTION_ALIGNMENT - 1);
+}
+
+void padMapSection(FILE* output)
+{
+    static char const padding[MAP_SECTION_ALIGNMENT] = {};
+    uint32 offset = uint32(ftell(output));
+    fwrite(padding, 1, alignMapSection(offset) - offset, output);
+}
+
 float selectUInt8StepStore(float maxDiff)
 {
     return 255 / maxDiff;
@@ -347,7 +360,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
         }
     }
 
-    map.areaMapOffset = sizeof(map);
+    map.areaMapOffset = alignMapSection(sizeof(map));
     map.areaMapSize   = sizeof(GridMapAreaHeader);
 
     GridMapAreaHeader areaHeader;
@@ -476,7 +489,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
             maxHeight = CONF_use_minHeight;
     }
 
-    map.heightMapOffset = map.areaMapOffset + map.areaMapSize;
+    map.heightMapOffset = alignMapSection(map.areaMapOffset + map.areaMapSize);
     map.heightMapSize = sizeof(GridMapHeightHeader);
 
     GridMapHeightHeader heightHeader;
@@ -723,7 +736,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
                 }
             }
         }
-        map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
+        map.liquidMapOffset = alignMapSection(map.heightMapOffset + map.heightMapSize);
         map.liquidMapSize = sizeof(GridMapLiquidHeader);
         liquidHeader.fourcc = *(uint32 const*)MAP_LIQUID_MAGIC;
         liquidHeader.flags = 0;
@@ -761,9 +774,9 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
     if (map.liquidMapOffset)
-        map.holesOffset = map.liquidMapOffset + map.liquidMapSize;
+        map.holesOffset = alignMapSection(map.liquidMapOffset + map.liquidMapSize);
     else
-        map.holesOffset = map.heightMapOffset + map.heightMapSize;
+        map.holesOffset = alignMapSection(map.heightMapOffset + map.heightMapSize);
 
     map.holesSize = sizeof(holes);
     memset(holes, 0, map.holesSize);
@@ -788,11 +801,13 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     }
     fwrite(&map, sizeof(map), 1, output);
     // Store area data
+    padMapSection(output);
     fwrite(&areaHeader, sizeof(areaHeader), 1, output);
     if (!(areaHeader.flags & MAP_AREA_NO_AREA))
         fwrite(area_flags, sizeof(area_flags), 1, output);
 
     // Store height data
+    padMapSection(output);
     fwrite(&heightHeader, sizeof(heightHeader), 1, output);
     if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
     {
@@ -816,6 +831,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
+        padMapSection(output);
         fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
         if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
         {
@@ -830,6 +846,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     }
 
     // store hole data
+    padMapSection(output);
     fwrite(holes, map.holesSize, 1, output);
 
     fclose(output);
@@ -12,6 +12,8 @@
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
 #include <mutex>
+#include <deque>
+#include <memory>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -59,14 +61,17 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * Most methods return -1 on failure.
  * The class uses reference counting.
  *
- * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
- * does really a lot of small-size writes to it, and it doesn't
- * scale well to allocate memory for every. When something is
- * written to the output buffer the socket is not immediately
- * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() method).
+ * For output the class keeps a queue of packets. Packets are
+ * not copied again: the queue is written with one sendmsg()
+ * of up to MAX_OUT_IOV segments (and m_OutBufferSize bytes).
+ * The network thread moves the queued packets to its own
+ * m_SendQueue under m_OutBufferLock, then encrypts their
+ * headers and writes them without holding the lock, so the
+ * threads queuing packets never wait for the cipher.
+ * When something is queued the socket is not immediately
+ * activated for output, because the server does a lot of
+ * small-size writes to it, there is 10ms celling (thats
+ * why there is Update() method).
  * This concept is similar to TCP_CORK, but TCP_CORK
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
@@ -75,10 +80,10 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * The calls to Update () method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
- * For input ,the class uses one 1024 bytes buffer on stack
+ * For input ,the class uses one 4096 bytes buffer on stack
  * to which it does recv() calls. And then received data is
- * distributed where its needed. 1024 matches pretty well the
- * traffic generated by client for now.
+ * distributed where its needed. Up to MAX_RECV_PER_EVENT
+ * reads are done per event before going back to the reactor.
  *
  * The input/output do speculative reads/writes (AKA it tryes
  * to read all data available in the kernel buffer or tryes to
@@ -105,8 +110,15 @@ class MangosSocket : public WorldHandler
         using LockType = std::mutex;
         typedef std::unique_lock<LockType> GuardType;
 
-        /// Queue for storing packets for which there is no space.
-        typedef ACE_Unbounded_Queue<WorldPacket*> PacketQueueT;
+        /// Packet waiting to be written, with the header for this socket.
+        /// Shared packets (broadcasts) are queued without being copied.
+        struct OutSegment
+        {
+            ServerPktHeader header;
+            bool encrypt;                                   // header not encrypted yet
+            std::shared_ptr<WorldPacket const> packet;
+        };
+        typedef std::deque<OutSegment> OutQueueT;
 
         /// Check if socket is closed.
         bool IsClosed() const { return closing_; }
@@ -128,6 +140,10 @@ class MangosSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket (const WorldPacket& pct);
 
+        /// Send a packet shared with other sockets, only referenced.
+        /// Header is encrypted for this socket when the packet is written.
+        int SendPacket (const std::shared_ptr<WorldPacket const>& pct);
+
         /// Add reference to this object.
         long AddReference() { return static_cast<long>(add_reference()); }
 
@@ -159,6 +175,9 @@ class MangosSocket : public WorldHandler
         /// Called by WorldSocketMgr/ReactorRunnable.
         int Update (void);
 
+        /// Maximum number of recv() calls done by one handle_input().
+        static const int MAX_RECV_PER_EVENT = 8;
+
         /// Helper functions for processing incoming data.
         int handle_input_header (void);
         int handle_input_payload (void);
@@ -169,15 +188,12 @@ class MangosSocket : public WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Try to write WorldPacket to m_OutBuffer ,return -1 if no space
+        /// Build the header and add the packet to m_OutQueue
         /// Need to be called with m_OutBufferLock lock held
-        int iSendPacket (const WorldPacket& pct);
+        void iSendPacket (std::shared_ptr<WorldPacket const> pct);
 
-        /// Flush m_PacketQueue if there are packets in it
-        /// Need to be called with m_OutBufferLock lock held
-        /// @return true if it wrote to the buffer ( AKA you need
-        /// to mark the socket for output ).
-        bool iFlushPacketQueue ();
+        /// Maximum number of iovec given to one sendmsg()
+        static const int MAX_OUT_IOV = 64;
 
         /// Time in which the last ping was received
         ACE_Time_Value m_LastPingTime;
@@ -211,15 +227,20 @@ class MangosSocket : public WorldHandler
         /// Mutex for protecting output related data.
         LockType m_OutBufferLock;
 
-        /// Buffer used for writing output.
-        ACE_Message_Block *m_OutBuffer;
+        /// Packets waiting to be written, in order.
+        OutQueueT m_OutQueue;
+
+        /// Packets taken from m_OutQueue by the network thread, only used by that thread.
+        OutQueueT m_SendQueue;
+
+        /// Bytes of the first packet of m_SendQueue already written, header included.
+        size_t m_SendQueueSent;
 
-        /// Size of the m_OutBuffer.
+        /// Maximum number of bytes written by one sendmsg().
         size_t m_OutBufferSize;
 
-        /// Here are stored packets for which there was no space on m_OutBuffer,
-        /// this allows not-to kick player if its buffer is overflowed.
-        PacketQueueT m_PacketQueue;
+        /// True once open() was called.
+        bool m_Opened;
 
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
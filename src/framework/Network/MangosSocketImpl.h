@@ -5,6 +5,7 @@
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
+#include <ace/os_include/sys/os_uio.h>
 #include <ace/OS_NS_string.h>
 #include <ace/Reactor.h>
 
@@ -32,8 +33,9 @@ MangosSocket<SessionType, SocketName, Crypt>::MangosSocket() :
     m_RecvWPct(0),
     m_RecvPct(),
     m_Header(sizeof(ClientPktHeader)),
-    m_OutBuffer(0),
+    m_SendQueueSent(0),
     m_OutBufferSize(65536),
+    m_Opened(false),
     m_OutActive(false),
     m_Seed(static_cast<uint32>(rand32())),
     m_isServerSocket(true)
@@ -46,16 +48,9 @@ MangosSocket<SessionType, SocketName, Crypt>::~MangosSocket(void)
 {
     delete m_RecvWPct;
 
-    if (m_OutBuffer)
-        m_OutBuffer->release();
-
     closing_ = true;
 
     peer().close();
-
-    WorldPacket* pct;
-    while (m_PacketQueue.dequeue_head(pct) == 0)
-        delete pct;
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
@@ -86,21 +81,22 @@ int MangosSocket<SessionType, SocketName, Crypt>::SendPacket(const WorldPacket&
     if (closing_)
         return -1;
 
-    if (((SocketName*)this)->iSendPacket(pct) == -1)
-    {
-        WorldPacket* npct;
+    // NOTE maybe check of the size of the queue can be good ?
+    // to make it bounded instead of unbounded
+    ((SocketName*)this)->iSendPacket(MakeSharedPacket(WorldPacket(pct)));
 
-        ACE_NEW_RETURN(npct, WorldPacket(pct), -1);
+    return 0;
+}
 
-        // NOTE maybe check of the size of the queue can be good ?
-        // to make it bounded instead of unbounded
-        if (m_PacketQueue.enqueue_tail(npct) == -1)
-        {
-            delete npct;
-            sLog.outError("MangosSocket<SessionType, SocketName, Crypt>::SendPacket: m_PacketQueue.enqueue_tail failed");
-            return -1;
-        }
-    }
+template <typename SessionType, typename SocketName, typename Crypt>
+int MangosSocket<SessionType, SocketName, Crypt>::SendPacket(const std::shared_ptr<WorldPacket const>& pct)
+{
+    GuardType lock(m_OutBufferLock);
+
+    if (closing_)
+        return -1;
+
+    ((SocketName*)this)->iSendPacket(pct);
 
     return 0;
 }
@@ -111,9 +107,11 @@ int MangosSocket<SessionType, SocketName, Crypt>::open(void *a)
     ACE_UNUSED_ARG(a);
 
     // Prevent double call to this func.
-    if (m_OutBuffer)
+    if (m_Opened)
         return -1;
 
+    m_Opened = true;
+
     // This will also prevent the socket from being Updated
     // while we are initializing it.
     m_OutActive = true;
@@ -122,9 +120,6 @@ int MangosSocket<SessionType, SocketName, Crypt>::open(void *a)
     if (((SocketName*)this)->OnSocketOpen() == -1)
         return -1;
 
-    // Allocate the buffer.
-    ACE_NEW_RETURN(m_OutBuffer, ACE_Message_Block(m_OutBufferSize), -1);
-
     // Store peer address.
     ACE_INET_Addr remote_addr;
 
@@ -209,15 +204,64 @@ int MangosSocket<SessionType, SocketName, Crypt>::handle_output(ACE_HANDLE)
     if (closing_)
         return -1;
 
-    const size_t send_len = m_OutBuffer->length();
+    // Take the packets to write from the shared queue. Only this thread uses
+    // m_SendQueue, the headers are encrypted and written without the lock.
+    while (!m_OutQueue.empty() && m_SendQueue.size() < MAX_OUT_IOV / 2)
+    {
+        m_SendQueue.push_back(std::move(m_OutQueue.front()));
+        m_OutQueue.pop_front();
+    }
 
-    if (send_len == 0)
+    if (m_SendQueue.empty())
         return cancel_wakeup_output(lock);
 
+    lock.unlock();
+
+    // Gather the header and the payload of the packets. Packets are gathered
+    // in order from the front, so headers are encrypted in order.
+    iovec iov[MAX_OUT_IOV];
+    int iov_count = 0;
+    size_t send_len = 0;
+    size_t skip = m_SendQueueSent;
+
+    for (typename OutQueueT::iterator itr = m_SendQueue.begin(); itr != m_SendQueue.end(); ++itr)
+    {
+        if (iov_count + 2 > MAX_OUT_IOV || send_len >= m_OutBufferSize)
+            break;
+
+        if (itr->encrypt)
+        {
+            m_Crypt.EncryptSend((uint8*) &itr->header, sizeof(itr->header));
+            itr->encrypt = false;
+        }
+
+        if (skip < sizeof(ServerPktHeader))
+        {
+            iov[iov_count].iov_base = (char*) &itr->header + skip;
+            iov[iov_count].iov_len = sizeof(ServerPktHeader) - skip;
+            send_len += iov[iov_count++].iov_len;
+            skip = 0;
+        }
+        else
+            skip -= sizeof(ServerPktHeader);
+
+        if (itr->packet->size() > skip)
+        {
+            iov[iov_count].iov_base = (char*) itr->packet->contents() + skip;
+            iov[iov_count].iov_len = itr->packet->size() - skip;
+            send_len += iov[iov_count++].iov_len;
+        }
+        skip = 0;
+    }
+
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_count;
+    ssize_t n = ::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv(iov, iov_count);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -225,30 +269,33 @@ int MangosSocket<SessionType, SocketName, Crypt>::handle_output(ACE_HANDLE)
     else if (n == -1)
     {
         if (errno == EWOULDBLOCK || errno == EAGAIN)
+        {
+            lock.lock();
             return schedule_wakeup_output(lock);
+        }
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
-
-        return schedule_wakeup_output(lock);
-    }
-    else //now n == send_len
+    // Release the packets written completely
+    size_t written = m_SendQueueSent + static_cast<size_t>(n);
+    while (!m_SendQueue.empty())
     {
-        m_OutBuffer->reset();
+        size_t const segment_len = sizeof(ServerPktHeader) + m_SendQueue.front().packet->size();
+        if (written < segment_len)
+            break;
 
-        if (!iFlushPacketQueue())
-            return cancel_wakeup_output(lock);
-        else
-            return schedule_wakeup_output(lock);
+        written -= segment_len;
+        m_SendQueue.pop_front();
     }
+    m_SendQueueSent = written;
+
+    lock.lock();
 
-    ACE_NOTREACHED(return 0);
+    if (m_SendQueue.empty() && m_OutQueue.empty())
+        return cancel_wakeup_output(lock);
+
+    return schedule_wakeup_output(lock);
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
@@ -281,7 +328,7 @@ int MangosSocket<SessionType, SocketName, Crypt>::Update(void)
     if (closing_)
         return -1;
 
-    if (m_OutActive || m_OutBuffer->length() == 0)
+    if (m_OutActive || (m_OutQueue.empty() && m_SendQueue.empty()))
         return 0;
 
     return handle_output(get_handle());
@@ -354,89 +401,104 @@ int MangosSocket<SessionType, SocketName, Crypt>::handle_input_missing_data(void
 {
     char buf [4096];
 
-    ACE_Data_Block db(sizeof(buf),
-                      ACE_Message_Block::MB_DATA,
-                      buf,
-                      0,
-                      0,
-                      ACE_Message_Block::DONT_DELETE,
-                      0);
+    // Drain the kernel buffer with several reads per event instead of going back
+    // to the reactor after each one, but bounded so a flooding peer can not hold
+    // the network thread.
+    for (int reads = 0; reads < MAX_RECV_PER_EVENT; ++reads)
+    {
+        ACE_Data_Block db(sizeof(buf),
+                          ACE_Message_Block::MB_DATA,
+                          buf,
+                          0,
+                          0,
+                          ACE_Message_Block::DONT_DELETE,
+                          0);
+
+        ACE_Message_Block message_block(&db,
+                                        ACE_Message_Block::DONT_DELETE,
+                                        0);
 
-    ACE_Message_Block message_block(&db,
-                                    ACE_Message_Block::DONT_DELETE,
-                                    0);
+        const size_t recv_size = message_block.space();
 
-    const size_t recv_size = message_block.space();
+        const ssize_t n = peer().recv(message_block.wr_ptr(),
+                                      recv_size);
 
-    const ssize_t n = peer().recv(message_block.wr_ptr(),
-                                  recv_size);
+        if (n <= 0)
+        {
+            // Nothing more for now, but the previous reads got data
+            if (reads > 0 && n == -1 && (errno == EWOULDBLOCK || errno == EAGAIN))
+                return 2;
 
-    if (n <= 0)
-        return (int)n;
+            return (int)n;
+        }
 
-    message_block.wr_ptr(n);
+        message_block.wr_ptr(n);
 
-    while (message_block.length() > 0)
-    {
-        if (m_Header.space() > 0)
+        while (message_block.length() > 0)
         {
-            //need to receive the header
-            const size_t to_header = (message_block.length() > m_Header.space() ? m_Header.space() : message_block.length());
-            m_Header.copy(message_block.rd_ptr(), to_header);
-            message_block.rd_ptr(to_header);
-
             if (m_Header.space() > 0)
             {
-                // Couldn't receive the whole header this time.
-                MANGOS_ASSERT(message_block.length() == 0);
-                errno = EWOULDBLOCK;
-                return -1;
+                //need to receive the header
+                const size_t to_header = (message_block.length() > m_Header.space() ? m_Header.space() : message_block.length());
+                m_Header.copy(message_block.rd_ptr(), to_header);
+                message_block.rd_ptr(to_header);
+
+                if (m_Header.space() > 0)
+                {
+                    // Couldn't receive the whole header this time.
+                    MANGOS_ASSERT(message_block.length() == 0);
+                    break;
+                }
+
+                // We just received nice new header
+                if (handle_input_header() == -1)
+                {
+                    MANGOS_ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
+                    return -1;
+                }
             }
 
-            // We just received nice new header
-            if (handle_input_header() == -1)
+            // Its possible on some error situations that this happens
+            // for example on closing when epoll receives more chunked data and stuff
+            // hope this is not hack ,as proper m_RecvWPct is asserted around
+            if (!m_RecvWPct)
             {
-                MANGOS_ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
+                sLog.outError("Forcing close on input m_RecvWPct = nullptr");
+                errno = EINVAL;
                 return -1;
             }
-        }
-
-        // Its possible on some error situations that this happens
-        // for example on closing when epoll receives more chunked data and stuff
-        // hope this is not hack ,as proper m_RecvWPct is asserted around
-        if (!m_RecvWPct)
-        {
-            sLog.outError("Forcing close on input m_RecvWPct = nullptr");
-            errno = EINVAL;
-            return -1;
-        }
-
-        // We have full read header, now check the data payload
-        if (m_RecvPct.space() > 0)
-        {
-            //need more data in the payload
-            const size_t to_data = (message_block.length() > m_RecvPct.space() ? m_RecvPct.space() : message_block.length());
-            m_RecvPct.copy(message_block.rd_ptr(), to_data);
-            message_block.rd_ptr(to_data);
 
+            // We have full read header, now check the data payload
             if (m_RecvPct.space() > 0)
             {
-                // Couldn't receive the whole data this time.
-                MANGOS_ASSERT(message_block.length() == 0);
-                errno = EWOULDBLOCK;
+                //need more data in the payload
+                const size_t to_data = (message_block.length() > m_RecvPct.space() ? m_RecvPct.space() : message_block.length());
+                m_RecvPct.copy(message_block.rd_ptr(), to_data);
+                message_block.rd_ptr(to_data);
+
+                if (m_RecvPct.space() > 0)
+                {
+                    // Couldn't receive the whole data this time.
+                    MANGOS_ASSERT(message_block.length() == 0);
+                    break;
+                }
+            }
+
+            //just received fresh new payload
+            if (handle_input_payload() == -1)
+            {
+                MANGOS_ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
                 return -1;
             }
         }
 
-        //just received fresh new payload
-        if (handle_input_payload() == -1)
-        {
-            MANGOS_ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
-            return -1;
-        }
+        // The kernel buffer is empty
+        if (size_t(n) < recv_size)
+            return 2;
     }
 
-    return size_t(n) == recv_size ? 1 : 2;
+    // Still data pending, let the reactor call us again
+    return 1;
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
@@ -481,60 +543,19 @@ int MangosSocket<SessionType, SocketName, Crypt>::schedule_wakeup_output(GuardTy
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
-int MangosSocket<SessionType, SocketName, Crypt>::iSendPacket(const WorldPacket& pct)
+void MangosSocket<SessionType, SocketName, Crypt>::iSendPacket(std::shared_ptr<WorldPacket const> pct)
 {
-    if (m_OutBuffer->space() < pct.size() + sizeof(ServerPktHeader))
-    {
-        errno = ENOBUFS;
-        return -1;
-    }
+    OutSegment segment;
 
-    ServerPktHeader header;
+    segment.header.cmd = pct->GetOpcode();
 
-    header.cmd = pct.GetOpcode();
+    segment.header.size = (uint16) pct->size() + 2;
 
-    header.size = (uint16) pct.size() + 2;
-
-    EndianConvertReverse(header.size);
-    EndianConvert(header.cmd);
-
-    m_Crypt.EncryptSend((uint8*) & header, sizeof(header));
-
-    if (m_OutBuffer->copy((char*) & header, sizeof(header)) == -1)
-        ACE_ASSERT(false);
-
-    if (!pct.empty())
-        if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
-            ACE_ASSERT(false);
-
-    return 0;
-}
-
-template <typename SessionType, typename SocketName, typename Crypt>
-bool MangosSocket<SessionType, SocketName, Crypt>::iFlushPacketQueue()
-{
-    WorldPacket *pct;
-    bool haveone = false;
-
-    while (m_PacketQueue.dequeue_head(pct) == 0)
-    {
-        if (((SocketName*)this)->iSendPacket(*pct) == -1)
-        {
-            if (m_PacketQueue.enqueue_head(pct) == -1)
-            {
-                delete pct;
-                sLog.outError("MangosSocket<SessionType, SocketName, Crypt>::iFlushPacketQueue m_PacketQueue->enqueue_head");
-                return false;
-            }
-
-            break;
-        }
-        else
-        {
-            haveone = true;
-            delete pct;
-        }
-    }
+    EndianConvertReverse(segment.header.size);
+    EndianConvert(segment.header.cmd);
 
-    return haveone;
+    // Packets queued before the key is set are sent in clear
+    segment.encrypt = m_Crypt.IsInitialized();
+    segment.packet = std::move(pct);
+    m_OutQueue.push_back(std::move(segment));
 }
@@ -31,6 +31,8 @@ class MangosSocketMgr
         void SetThreads(int v) { m_NetThreadsCount = v; }
         void SetTcpNodelay(bool v) { m_UseNoDelay = v; }
         void SetInterval(int v) { m_Interval = v * 1000; /* to microseconds */ }
+        /// Pins network thread N to processor first + N, -1 to let the system schedule them.
+        void SetThreadAffinity(int first) { m_ThreadAffinity = first; }
 
         int Connect(int port, std::string const& address, SocketType*& sock);
     protected:
@@ -48,6 +50,7 @@ class MangosSocketMgr
         int m_SockOutUBuff;
         bool m_UseNoDelay;
         int m_Interval;
+        int m_ThreadAffinity;
 
         std::string m_addr;
         ACE_UINT16 m_port;
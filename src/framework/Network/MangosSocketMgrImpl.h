@@ -17,6 +17,12 @@
 
 #include <set>
 #include <atomic>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "Log.h"
 #include "Common.h"
@@ -70,7 +76,8 @@ public:
         m_Reactor(0),
         m_Connections(0),
         m_ThreadId(-1),
-        m_Interval(0)
+        m_Interval(0),
+        m_Cpu(-1)
     {
         ACE_Reactor_Impl* imp = 0;
 
@@ -104,6 +111,12 @@ public:
         m_Reactor->end_reactor_event_loop();
     }
 
+    /// Pins the thread to this processor when it starts, -1 for no affinity
+    void SetCpu(int cpu)
+    {
+        m_Cpu = cpu;
+    }
+
     int Start(int interval)
     {
         m_Interval = interval;
@@ -169,6 +182,18 @@ protected:
     {
         DEBUG_LOG("Network Thread Starting");
 
+#ifdef __linux__
+        // Sockets never change of thread, keep their data in the cache of one core
+        if (m_Cpu >= 0)
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(m_Cpu, &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+                sLog.outError("Network thread: unable to set affinity to processor %d", m_Cpu);
+        }
+#endif
+
         WorldDatabase.ThreadStart();
 
         MANGOS_ASSERT(m_Reactor);
@@ -217,6 +242,7 @@ private:
     AtomicInt m_Connections;
     int m_ThreadId;
     int m_Interval;
+    int m_Cpu;
 
     SocketSet m_Sockets;
 
@@ -232,6 +258,7 @@ MangosSocketMgr<SocketType>::MangosSocketMgr():
     m_SockOutUBuff(65536),
     m_UseNoDelay(true),
     m_Interval(10000),
+    m_ThreadAffinity(-1),
     m_port(0),
     m_Acceptor(0)
 {
@@ -250,8 +277,13 @@ int MangosSocketMgr<SocketType>::StartThreadsIfNeeded()
     if (m_NetThreads)
         return 0;
     m_NetThreads = new ReactorRunnable<SocketType>[m_NetThreadsCount];
+    size_t const cpus = std::max(std::thread::hardware_concurrency(), 1u);
     for (size_t i = 0; i < m_NetThreadsCount; ++i)
+    {
+        if (m_ThreadAffinity >= 0)
+            m_NetThreads[i].SetCpu(int((m_ThreadAffinity + i) % cpus));
         m_NetThreads[i].Start(m_Interval);
+    }
     return 0;
 }
 
@@ -880,16 +880,28 @@ uint32 AuctionEntry::GetAuctionOutBid() const
 
 void AuctionEntry::DeleteFromDB() const
 {
-    //No SQL injection (Id is integer)
-    CharacterDatabase.PExecute("DELETE FROM `auction` WHERE `id` = '%u'", Id);
+    static SqlStatementID delAuction;
+    SqlStatement stmt = CharacterDatabase.CreateStatement(delAuction, "DELETE FROM `auction` WHERE `id` = ?");
+    stmt.PExecute(Id);
 }
 
 void AuctionEntry::SaveToDB() const
 {
-    //No SQL injection (no strings)
-    CharacterDatabase.PExecute("INSERT INTO `auction` (`id`, `house_id`, `item_guid`, `item_id`, `seller_guid`, `buyout_price`, `expire_time`, `buyer_guid`, `last_bid`, `start_bid`, `deposit`) "
-                               "VALUES ('%u', '%u', '%u', '%u', '%u', '%u', '" UI64FMTD "', '%u', '%u', '%u', '%u')",
-                               Id, auctionHouseEntry->houseId, itemGuidLow, itemTemplate, owner, buyout, (uint64)expireTime, bidder, bid, startbid, deposit);
+    static SqlStatementID insAuction;
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insAuction, "INSERT INTO `auction` (`id`, `house_id`, `item_guid`, `item_id`, `seller_guid`, `buyout_price`, `expire_time`, `buyer_guid`, `last_bid`, `start_bid`, `deposit`) "
+                                                          "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    stmt.addUInt32(Id);
+    stmt.addUInt32(auctionHouseEntry->houseId);
+    stmt.addUInt32(itemGuidLow);
+    stmt.addUInt32(itemTemplate);
+    stmt.addUInt32(owner);
+    stmt.addUInt32(buyout);
+    stmt.addUInt64(uint64(expireTime));
+    stmt.addUInt32(bidder);
+    stmt.addUInt32(bid);
+    stmt.addUInt32(startbid);
+    stmt.addUInt32(deposit);
+    stmt.Execute();
 }
 
 bool AuctionEntry::IsAvailableFor(Player* player)
@@ -354,6 +354,9 @@ ChatCommand * ChatHandler::getCommandTable()
         { "loottable",      SEC_DEVELOPER,      true,  &ChatHandler::HandleDebugLootTableCommand,           "", nullptr },
         { "utf8overflow",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugOverflowCommand,            "", nullptr },
         { "chatfreeze",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugChatFreezeCommand,          "", nullptr },
+        { "recvqueue",      SEC_DEVELOPER,      true,  &ChatHandler::HandleDebugRecvQueueCommand,           "", nullptr },
+        { "packetpool",     SEC_DEVELOPER,      true,  &ChatHandler::HandleDebugPacketPoolCommand,          "", nullptr },
+        { "dbqueues",       SEC_DEVELOPER,      true,  &ChatHandler::HandleDebugDbQueuesCommand,            "", nullptr },
         {  nullptr,         0,                  false, nullptr,                                             "", nullptr }
     };
 
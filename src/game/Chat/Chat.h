@@ -457,6 +457,9 @@ class ChatHandler
         bool HandleDebugSpellModsCommand(char* args);
         bool HandleDebugOverflowCommand(char* args);
         bool HandleDebugChatFreezeCommand(char* args);
+        bool HandleDebugRecvQueueCommand(char* args);
+        bool HandleDebugPacketPoolCommand(char* args);
+        bool HandleDebugDbQueuesCommand(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlaySoundCommand(char* args);
@@ -429,7 +429,7 @@ bool ChatHandler::HandleAddCharacterNoteCommand(char* args)
         SetSentErrorMessage(true);
         return false;
     }
-    PlayerCacheData const* playerData = sObjectMgr.GetPlayerDataByGUID(playerGuid.GetCounter());
+    PlayerCacheDataPtr playerData = sObjectMgr.GetPlayerDataByGUID(playerGuid.GetCounter());
     if (!playerData)
     {
         PSendSysMessage(LANG_PLAYER_NOT_FOUND);
@@ -456,7 +456,7 @@ bool ChatHandler::HandleWarnCharacterCommand(char* args)
         SetSentErrorMessage(true);
         return false;
     }
-    PlayerCacheData const* playerData = sObjectMgr.GetPlayerDataByGUID(playerGuid.GetCounter());
+    PlayerCacheDataPtr playerData = sObjectMgr.GetPlayerDataByGUID(playerGuid.GetCounter());
     if (!playerData)
     {
         PSendSysMessage(LANG_PLAYER_NOT_FOUND);
@@ -1153,7 +1153,7 @@ bool ChatHandler::HandleMuteCommand(char* args)
 
     // Add warning to the account
     std::string authorName = m_session ? m_session->GetPlayerName() : "Console";
-    PlayerCacheData const* playerData = sObjectMgr.GetPlayerDataByGUID(target_guid);
+    PlayerCacheDataPtr playerData = sObjectMgr.GetPlayerDataByGUID(target_guid);
     ASSERT(playerData);
     std::stringstream reason;
     reason << playerData->sName << " muted " << notspeaktime << " minutes";
@@ -5085,15 +5085,12 @@ bool ChatHandler::HandlePetListCommand(char* args)
         SetSentErrorMessage(true);
         return false;
     }
-    CharPetMap const& petsMap = sCharacterDatabaseCache.GetCharPetsMap();
-    CharPetMap::const_iterator charPets = petsMap.find(playerGuid.GetCounter());
     uint32 count = 0;
-    if (charPets != petsMap.end())
-        for (const auto it : charPets->second)
-        {
-            PSendSysMessage("#%u: \"%s\" (%s)", it->id, it->name.c_str(), it->slot == PET_SAVE_AS_CURRENT ? "Current pet" : "In stable");
-            ++count;
-        }
+    for (const auto it : sCharacterDatabaseCache.GetCharacterPets(playerGuid.GetCounter()))
+    {
+        PSendSysMessage("#%u: \"%s\" (%s)", it->id, it->name.c_str(), it->slot == PET_SAVE_AS_CURRENT ? "Current pet" : "In stable");
+        ++count;
+    }
     PSendSysMessage("Found %u pets for character %s (#%u).", count, charName.c_str(), playerGuid.GetCounter());
     return true;
 }
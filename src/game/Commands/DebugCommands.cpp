@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SqlBatchWriter.h"
 #include "DBCStores.h"
 #include "WorldPacket.h"
 #include "Player.h"
@@ -1787,6 +1788,73 @@ bool ChatHandler::HandleDebugChatFreezeCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandleDebugRecvQueueCommand(char* args)
+{
+    Player* target;
+    if (!ExtractPlayerTarget(&args, &target))
+        return false;
+
+    static char const* const typeNames[PACKET_PROCESS_MAX_TYPE] = { "World", "Map", "Spells", "Movement", "DB query", "Master safe" };
+
+    WorldSession* session = target->GetSession();
+    PSendSysMessage("Receive queues of %s:", target->GetName());
+    for (uint32 i = 0; i < PACKET_PROCESS_MAX_TYPE; ++i)
+        PSendSysMessage("%s: %u/%u queued, %u overflows", typeNames[i], uint32(session->GetRecvQueueDepth(PacketProcessing(i))),
+            uint32(session->GetRecvQueueCapacity(PacketProcessing(i))), session->GetRecvQueueOverflows(PacketProcessing(i)));
+
+    return true;
+}
+
+bool ChatHandler::HandleDebugPacketPoolCommand(char* /*args*/)
+{
+    PacketBufferPool::Stats stats = PacketBufferPool::GetStats();
+    PSendSysMessage("Packet buffers: " UI64FMTD " allocated, " UI64FMTD " from heap, " UI64FMTD " freed to heap, " UI64FMTD " depot transfers",
+        uint64(stats.allocations), uint64(stats.heapAllocations), uint64(stats.heapFrees), uint64(stats.depotTransfers));
+    return true;
+}
+
+bool ChatHandler::HandleDebugDbQueuesCommand(char* /*args*/)
+{
+    std::pair<char const*, Database*> const databases[] =
+    {
+        { "World", &WorldDatabase },
+        { "Character", &CharacterDatabase },
+        { "Login", &LoginDatabase },
+        { "Logs", &LogsDatabase },
+    };
+
+    for (auto const& db : databases)
+    {
+        PSendSysMessage("%s database: %u queued for any worker", db.first, uint32(db.second->GetDelayQueueSize()));
+
+        std::vector<SqlDelayThread::Stats> const workers = db.second->GetAsyncWorkersStats();
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            SqlDelayThread::Stats const& stats = workers[i];
+            PSendSysMessage("  Worker #%u: %u queued | " UI64FMTD " executed, avg %uus, max %uus | <1ms " UI64FMTD " <4ms " UI64FMTD " <16ms " UI64FMTD " <64ms " UI64FMTD " <256ms " UI64FMTD " more " UI64FMTD,
+                uint32(i), uint32(stats.serialQueueSize), stats.executed,
+                uint32(stats.executed ? stats.totalTimeUs / stats.executed : 0), stats.maxTimeUs,
+                stats.latency[0], stats.latency[1], stats.latency[2], stats.latency[3], stats.latency[4], stats.latency[5]);
+        }
+    }
+
+    SqlBatchWriter::Stats const logs = sWorld.GetLogsWriter().GetStats();
+    PSendSysMessage("Logs batches: %u rows pending | " UI64FMTD " rows (" UI64FMTD " replaced) in " UI64FMTD " statements, " UI64FMTD " delayed flushes",
+        logs.pendingRows, logs.rows, logs.replacedRows, logs.statements, logs.deferredFlushes);
+
+    LatencySamples::Percentiles const queries = sWorld.GetLoginQueriesLatency().GetPercentiles();
+    LatencySamples::Percentiles const logins = sWorld.GetLoginLatency().GetPercentiles();
+    PSendSysMessage("Login queries: " UI64FMTD " holders, p50 %ums p90 %ums p99 %ums max %ums",
+        queries.count, queries.p50, queries.p90, queries.p99, queries.max);
+    PSendSysMessage("Logins: " UI64FMTD " characters loaded, p50 %ums p90 %ums p99 %ums max %ums",
+        logins.count, logins.p50, logins.p90, logins.p99, logins.max);
+
+    Player::SaveStats const saves = Player::GetSaveStats();
+    PSendSysMessage("Player saves: " UI64FMTD " saves, " UI64FMTD " statements, avg %.1f max %u per save",
+        saves.saves, saves.statements, saves.saves ? float(saves.statements) / saves.saves : 0.0f, saves.maxStatements);
+    return true;
+}
+
 bool ChatHandler::HandleDebugOverflowCommand(char* args)
 {
     std::string name("\360\222\214\245\360\222\221\243\360\222\221\251\360\223\213\215\360\223\213\210\360\223\211\241\360\222\214\245\360\222\221\243\360\222\221\251\360\223\213\215\360\223\213\210\360\223\211\241");
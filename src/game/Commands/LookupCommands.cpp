@@ -1087,7 +1087,7 @@ bool ChatHandler::HandleLookupPlayerCharacterCommand(char* args)
     QueryResult* result = nullptr;
     std::string normalizedName = nameStr;
     if (normalizePlayerName(normalizedName))
-        if (PlayerCacheData const* data = sObjectMgr.GetPlayerDataByName(normalizedName))
+        if (PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByName(normalizedName))
             if (result = LoginDatabase.PQuery("SELECT `id`, `last_ip` FROM `account` WHERE `id` = %u", data->uiAccount))
             {
                 Field* fields = result->Fetch();
@@ -815,6 +815,7 @@ bool ChatHandler::HandleInstanceStatsCommand(char* /*args*/)
 {
     PSendSysMessage("instances loaded: %d", sMapMgr.GetNumInstances());
     PSendSysMessage("players in instances: %d", sMapMgr.GetNumPlayersInInstances());
+    PSendSysMessage("instances at reduced tick rate: %d", sMapMgr.GetNumInstancesAtReducedTickRate());
 
     uint32 numSaves, numBoundPlayers, numBoundGroups;
     sMapPersistentStateMgr.GetStatistics(numSaves, numBoundPlayers, numBoundGroups);
@@ -0,0 +1,39 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef AURASAVESTRUCT_H
+#define AURASAVESTRUCT_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "DBCEnums.h"
+
+// Saved state of an aura, in character_aura and pet_aura
+struct AuraSaveStruct
+{
+    ObjectGuid casterGuid = 0;
+    uint32 itemLowGuid = 0;
+    uint32 spellId = 0;
+    uint32 stacks = 0;
+    uint32 charges = 0;
+    float  damage[MAX_EFFECT_INDEX] = { 0 };
+    uint32 periodicTime[MAX_EFFECT_INDEX] = { 0 };
+    int32 maxDuration = 0;
+    int32 duration = 0;
+    uint8 effIndexMask = 0;
+};
+
+#endif
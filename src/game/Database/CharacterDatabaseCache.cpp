@@ -36,6 +36,7 @@ void CharacterDatabaseCache::LoadCharacterPet(uint32 singlePetId)
     }
     else if (!singlePetId)
     {
+        std::unique_lock<std::mutex> lock(m_lock);
         m_petsByCharacter.clear();
         sLog.outString("* Loading table `character_pet`");
         result.reset(CharacterDatabase.Query(
@@ -98,8 +99,11 @@ void CharacterDatabaseCache::LoadPetSpell(uint32 singlePetId)
     else
     {
         // Clear previously stored spells
-        for (const auto& it : m_petsByGuid)
-            it.second->spells.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            for (const auto& it : m_petsByGuid)
+                it.second->spells.clear();
+        }
 
         sLog.outString("* Loading `pet_spell`");
         result.reset(CharacterDatabase.Query(
@@ -148,8 +152,11 @@ void CharacterDatabaseCache::LoadPetSpellCooldown(uint32 singlePetId)
     else
     {
         // Clear previously stored cooldowns
-        for (const auto& it : m_petsByGuid)
-            it.second->spellCooldowns.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            for (const auto& it : m_petsByGuid)
+                it.second->spellCooldowns.clear();
+        }
 
         sLog.outString("* Loading `pet_spell_cooldown`");
         result.reset(CharacterDatabase.Query(
@@ -200,8 +207,11 @@ void CharacterDatabaseCache::LoadPetAura(uint32 singlePetId)
     else
     {
         // Clear previously stored auras
-        for (const auto& it : m_petsByGuid)
-            it.second->auras.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            for (const auto& it : m_petsByGuid)
+                it.second->auras.clear();
+        }
 
         sLog.outString("* Loading table `pet_aura`");
         result.reset(CharacterDatabase.Query(
@@ -257,23 +267,27 @@ void CharacterDatabaseCache::LoadPetAura(uint32 singlePetId)
         sLog.outString("-> %u rows loaded.", count);
 }
 
-CharacterPetCache* CharacterDatabaseCache::GetCharacterPetById(uint32 id)
+CharacterPetCache* CharacterDatabaseCache::FindPetById(uint32 id) const
 {
-    PetGuidToPetMap::iterator petStruct = m_petsByGuid.find(id);
+    PetGuidToPetMap::const_iterator petStruct = m_petsByGuid.find(id);
     if (petStruct == m_petsByGuid.end())
         return nullptr;
     return petStruct->second;
 }
 
+CharacterPetCache* CharacterDatabaseCache::GetCharacterPetById(uint32 id)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    return FindPetById(id);
+}
+
 CharacterPetCache* CharacterDatabaseCache::GetCharacterPetCacheByOwnerAndId(uint32 ownerGuidLow, uint32 id)
 {
     // FROM character_pet WHERE owner_guid = '%u' AND id = '%u'
-    CharPetMap::iterator ownerPets = m_petsByCharacter.find(ownerGuidLow);
-    if (ownerPets == m_petsByCharacter.end())
-        return nullptr;
-    for (const auto& it : ownerPets->second)
-        if (it->id == id)
-            return it;
+    std::unique_lock<std::mutex> lock(m_lock);
+    CharacterPetCache* pet = FindPetById(id);
+    if (pet && pet->ownerGuid == ownerGuidLow)
+        return pet;
 
     return nullptr;
 }
@@ -281,6 +295,7 @@ CharacterPetCache* CharacterDatabaseCache::GetCharacterPetCacheByOwnerAndId(uint
 CharacterPetCache* CharacterDatabaseCache::GetCharacterCurrentPet(uint32 ownerGuidLow)
 {
     // FROM character_pet WHERE owner_guid = '%u' AND slot = 'PET_SAVE_AS_CURRENT'
+    std::unique_lock<std::mutex> lock(m_lock);
     CharPetMap::iterator ownerPets = m_petsByCharacter.find(ownerGuidLow);
     if (ownerPets == m_petsByCharacter.end())
         return nullptr;
@@ -294,6 +309,7 @@ CharacterPetCache* CharacterDatabaseCache::GetCharacterCurrentPet(uint32 ownerGu
 CharacterPetCache* CharacterDatabaseCache::GetCharacterPetByOwnerAndEntry(uint32 ownerGuidLow, uint32 entry)
 {
     // FROM character_pet WHERE owner_guid = '%u' AND entry = '%u' AND (slot = 'PET_SAVE_AS_CURRENT' OR slot > 'PET_SAVE_LAST_STABLE_SLOT')
+    std::unique_lock<std::mutex> lock(m_lock);
     CharPetMap::iterator ownerPets = m_petsByCharacter.find(ownerGuidLow);
     if (ownerPets == m_petsByCharacter.end())
         return nullptr;
@@ -307,6 +323,7 @@ CharacterPetCache* CharacterDatabaseCache::GetCharacterPetByOwnerAndEntry(uint32
 CharacterPetCache* CharacterDatabaseCache::GetCharacterPetByOwner(uint32 ownerGuidLow)
 {
     // FROM character_pet WHERE owner_guid = '%u' AND (slot = 'PET_SAVE_AS_CURRENT' OR slot > 'PET_SAVE_LAST_STABLE_SLOT')
+    std::unique_lock<std::mutex> lock(m_lock);
     CharPetMap::iterator ownerPets = m_petsByCharacter.find(ownerGuidLow);
     if (ownerPets == m_petsByCharacter.end())
         return nullptr;
@@ -317,8 +334,18 @@ CharacterPetCache* CharacterDatabaseCache::GetCharacterPetByOwner(uint32 ownerGu
     return nullptr;
 }
 
+CharPetVector CharacterDatabaseCache::GetCharacterPets(uint32 ownerGuidLow) const
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    CharPetMap::const_iterator ownerPets = m_petsByCharacter.find(ownerGuidLow);
+    if (ownerPets == m_petsByCharacter.end())
+        return CharPetVector();
+    return ownerPets->second;
+}
+
 void CharacterDatabaseCache::CharacterPetSetOthersNotInSlot(CharacterPetCache* pCache)
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     CharPetMap::iterator ownerPets = m_petsByCharacter.find(pCache->ownerGuid);
     if (ownerPets == m_petsByCharacter.end())
         return;
@@ -329,12 +356,14 @@ void CharacterDatabaseCache::CharacterPetSetOthersNotInSlot(CharacterPetCache* p
 
 void CharacterDatabaseCache::InsertCharacterPet(CharacterPetCache* cache)
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     m_petsByCharacter[cache->ownerGuid].push_back(cache);
     m_petsByGuid[cache->id] = cache;
 }
 
 void CharacterDatabaseCache::DeleteCharacterPetById(uint32 id)
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     PetGuidToPetMap::iterator petStruct = m_petsByGuid.find(id);
     if (petStruct == m_petsByGuid.end())
         return;
@@ -345,12 +374,15 @@ void CharacterDatabaseCache::DeleteCharacterPetById(uint32 id)
             ownerPets->second.erase(it);
             break;
         }
+    if (ownerPets->second.empty())
+        m_petsByCharacter.erase(ownerPets);
     delete petStruct->second;
     m_petsByGuid.erase(petStruct);
 }
 
 uint32 CharacterDatabaseCache::GetNextAvailablePetNumber(uint32 minimumValue) const
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     // Returns an iterator pointing to $minimumValue if exists, or greater than $minimumValue
     PetGuidToPetMap::const_iterator it = m_petsByGuid.lower_bound(minimumValue);
     while (it != m_petsByGuid.end() && it->first == minimumValue)
@@ -4,6 +4,9 @@
 #include "Common.h"
 #include "ObjectGuid.h"
 #include "DBCEnums.h"
+#include "AuraSaveStruct.h"
+#include <mutex>
+#include <unordered_map>
 
 // pet_spell_cooldown
 struct PetSpellCoodown
@@ -22,20 +25,6 @@ struct PetSpellCache
 };
 typedef std::vector<PetSpellCache> PetSpells;
 
-struct AuraSaveStruct
-{
-    ObjectGuid casterGuid = 0;
-    uint32 itemLowGuid = 0;
-    uint32 spellId = 0;
-    uint32 stacks = 0;
-    uint32 charges = 0;
-    float  damage[MAX_EFFECT_INDEX] = { 0 };
-    uint32 periodicTime[MAX_EFFECT_INDEX] = { 0 };
-    int32 maxDuration = 0;
-    int32 duration = 0;
-    uint8 effIndexMask = 0;
-};
-
 // pet_aura
 typedef AuraSaveStruct PetAuraCache;
 typedef std::vector<PetAuraCache> PetAuras;
@@ -73,8 +62,8 @@ struct CharacterPetCache
 };
 
 typedef std::vector<CharacterPetCache*> CharPetVector;
-typedef std::map<uint32 /*owner guid*/, CharPetVector> CharPetMap;
-typedef std::map<uint32 /*pet guid*/, CharacterPetCache*> PetGuidToPetMap;
+typedef std::unordered_map<uint32 /*owner guid*/, CharPetVector> CharPetMap;
+typedef std::map<uint32 /*pet guid*/, CharacterPetCache*> PetGuidToPetMap;   // ordered for GetNextAvailablePetNumber
 
 class CharacterDatabaseCache
 {
@@ -98,15 +87,19 @@ class CharacterDatabaseCache
         CharacterPetCache* GetCharacterCurrentPet(uint32 owner);
         CharacterPetCache* GetCharacterPetByOwnerAndEntry(uint32 owner, uint32 entry);
         CharacterPetCache* GetCharacterPetByOwner(uint32 owner);
-        CharacterPetCache* GetCharacterPetById(uint32 id); // Very slow method (iterates over all the stored pets)
+        CharacterPetCache* GetCharacterPetById(uint32 id);
         void CharacterPetSetOthersNotInSlot(CharacterPetCache* pCache);
         void InsertCharacterPet(CharacterPetCache* cache);
         void DeleteCharacterPetById(uint32 id);
-        CharPetMap const& GetCharPetsMap() const { return m_petsByCharacter; }
+        // Copy of the list, the pets of a character can change while the caller iterates
+        CharPetVector GetCharacterPets(uint32 ownerGuidLow) const;
         uint32 GetNextAvailablePetNumber(uint32 minimumValue) const;
 
     protected:
-        // @TODO: Lock these structures for thread safety, and process stable opcodes per map
+        CharacterPetCache* FindPetById(uint32 id) const;
+
+        // Guards the maps, not the pets: a pet is only changed by the map of its owner
+        mutable std::mutex m_lock;
         CharPetMap      m_petsByCharacter;
         PetGuidToPetMap m_petsByGuid;
 
@@ -20,6 +20,8 @@
 #include "DBCStores.h"
 #include "Log.h"
 #include "ProgressBar.h"
+#include "Timer.h"
+#include "Util.h"
 #include "SharedDefines.h"
 #include "ObjectGuid.h"
 #include "DBCfmt.h"
@@ -186,6 +188,9 @@ void LoadDBCStores(std::string const& dataPath)
 
     uint32 const DBCFilesCount = 44;
 
+    uint32 const startTime = WorldTimer::getMSTime();
+    size_t const startMemory = GetProcessResidentMemory();
+
     BarGoLink bar(DBCFilesCount);
 
     StoreProblemList bad_dbc_files;
@@ -437,7 +442,9 @@ void LoadDBCStores(std::string const& dataPath)
     }
 
     sLog.outString();
-    sLog.outString(">> Initialized %d data stores", DBCFilesCount);
+    sLog.outString(">> Initialized %d data stores in %u ms", DBCFilesCount, WorldTimer::getMSTimeDiffToNow(startTime));
+    if (size_t const memory = GetProcessResidentMemory())
+        sLog.outString(">> Resident memory %u KB (%+d KB while loading the data stores)", uint32(memory / 1024), int32(memory / 1024) - int32(startMemory / 1024));
 }
 
 char const* GetPetName(uint32 petfamily, uint32 dbclang)
@@ -26,7 +26,7 @@
 #include "Database/SQLStorage.h"
 
 extern SQLStorage sCreatureStorage;
-extern SQLStorage sCreatureDataAddonStorage;
+extern SQLSortedStorage sCreatureDataAddonStorage;
 extern SQLStorage sCreatureDisplayInfoAddonStorage;
 extern SQLStorage sGameObjectDisplayInfoAddonStorage;
 extern SQLStorage sEquipmentStorage;
@@ -38,6 +38,6 @@ extern SQLStorage sAreaStorage;
 extern SQLStorage sMailTemplateStorage;
 extern SQLStorage sCreatureSpellDataStorage;
 
-extern SQLHashStorage sGOStorage;
+extern SQLSortedStorage sGOStorage;
 
 #endif
@@ -201,7 +201,7 @@ bool Group::LoadGroupFromDB(Field* fields)
 bool Group::LoadMemberFromDB(uint32 guidLow, uint8 subgroup, bool assistant)
 {
     // skip nonexistent member
-    PlayerCacheData const* data = sObjectMgr.GetPlayerDataByGUID(guidLow);
+    PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByGUID(guidLow);
     if (!data)
         return false;
 
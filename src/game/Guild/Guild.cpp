@@ -229,7 +229,7 @@ GuildAddStatus Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
     }
     else
     {
-        PlayerCacheData const* data = sObjectMgr.GetPlayerDataByGUID(lowguid);
+        PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByGUID(lowguid);
         if (!data)
             return GuildAddStatus::UNKNOWN_PLAYER;
         newmember.Name   = data->sName;
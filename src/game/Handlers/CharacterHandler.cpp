@@ -50,9 +50,14 @@ class LoginQueryHolder : public SqlQueryHolder
 private:
     uint32 m_accountId;
     ObjectGuid m_guid;
+    uint32 m_startTime;
 public:
     LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-        : SqlQueryHolder(guid.GetCounter()), m_accountId(accountId), m_guid(guid) { }
+        : SqlQueryHolder(guid.GetCounter()), m_accountId(accountId), m_guid(guid), m_startTime(WorldTimer::getMSTime())
+    {
+        // about 20 independent selects, shared between the character database workers
+        SetParallel(true);
+    }
     ~LoginQueryHolder()
     {
         // Queries should NOT be deleted by user
@@ -66,42 +71,60 @@ public:
     {
         return m_accountId;
     }
+    uint32 GetStartTime() const
+    {
+        return m_startTime;
+    }
     bool Initialize();
+private:
+    bool SetGuidStatement(size_t index, SqlStatementID& id, char const* sql);
 };
 
+// prepared statement with the character guid as only parameter
+bool LoginQueryHolder::SetGuidStatement(size_t index, SqlStatementID& id, char const* sql)
+{
+    SqlStatement stmt = CharacterDatabase.CreateStatement(id, sql);
+    stmt.addUInt32(m_guid.GetCounter());
+    return SetStatement(index, stmt);
+}
+
 bool LoginQueryHolder::Initialize()
 {
     SetSize(MAX_PLAYER_LOGIN_QUERY);
 
+    static SqlStatementID loadFrom, loadGroup, loadBoundInstances, loadAuras, loadSpells, loadQuestStatus, loadHonorCP,
+        loadReputation, loadInventory, loadItemLoot, loadActions, loadSocialList, loadHomeBind, loadSpellCooldowns,
+        loadGuild, loadBGData, loadSkills, loadMails, loadMailedItems, loadForgottenSkills;
+
     bool res = true;
 
     // NOTE: all fields in `characters` must be read to prevent lost character data at next save in case wrong DB structure.
     // !!! NOTE: including unused `zone`,`online`
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADFROM,            "SELECT `guid`, `account`, `name`, `race`, `class`, `gender`, `level`, `xp`, `money`, `skin`, `face`, `hair_style`, `hair_color`, `facial_hair`, `bank_bag_slots`, `player_flags`, "
-                     "`position_x`, `position_y`, `position_z`, `map`, `orientation`, `known_taxi_mask`, `played_time_total`, `played_time_level`, `rest_bonus`, `logout_time`, `is_logout_resting`, `reset_talents_multiplier`, "
-                     "`reset_talents_time`, `transport_guid`, `transport_x`, `transport_y`, `transport_z`, `transport_o`, `extra_flags`, `stable_slots`, `at_login_flags`, `zone`, `online`, `death_expire_time`, `current_taxi_path`, "
-                     "`honor_rank_points`, `honor_highest_rank`, `honor_standing`, `honor_last_week_hk`, `honor_last_week_cp`, `honor_stored_hk`, `honor_stored_dk`, "
-                     "`watched_faction`, `drunk`, `health`, `power1`, `power2`, `power3`, `power4`, `power5`, `explored_zones`, `equipment_cache`, `ammo_id`, `action_bars`, "
-                     "`world_phase_mask`, `create_time` FROM `characters` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADGROUP,           "SELECT `group_id` FROM `group_member` WHERE `member_guid` ='%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADBOUNDINSTANCES,  "SELECT `id`, `permanent`, `map`, `reset_time` FROM `character_instance` LEFT JOIN `instance` ON `instance` = `id` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADAURAS,           "SELECT `caster_guid`, `item_guid`, `spell`, `stacks`, `charges`, `base_points0`, `base_points1`, `base_points2`, `periodic_time0`, `periodic_time1`, `periodic_time2`, `max_duration`, `duration`, `effect_index_mask` FROM `character_aura` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSPELLS,          "SELECT `spell`, `active`, `disabled` FROM `character_spell` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADQUESTSTATUS,     "SELECT `quest`, `status`, `rewarded`, `explored`, `timer`, `mob_count1`, `mob_count2`, `mob_count3`, `mob_count4`, `item_count1`, `item_count2`, `item_count3`, `item_count4`, `reward_choice` FROM `character_queststatus` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADHONORCP,         "SELECT `victim_type`, `victim_id`, `cp`, `date`, `type` FROM `character_honor_cp` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADREPUTATION,      "SELECT `faction`, `standing`, `flags` FROM `character_reputation` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADINVENTORY,       "SELECT * FROM (SELECT `creator_guid`, `gift_creator_guid`, `count`, `duration`, `charges`, `flags`, `enchantments`, `random_property_id`, `durability`, `text`, `bag`, `slot`, `item_guid`, `item_instance`.`item_id`, `generated_loot` FROM `character_inventory` JOIN `item_instance` ON `character_inventory`.`item_guid` = `item_instance`.`guid` WHERE `character_inventory`.`guid` = '%u') as t ORDER BY `bag`, `slot`", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADITEMLOOT,        "SELECT `guid`, `item_id`, `amount`, `property` FROM `item_loot` WHERE `owner_guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADACTIONS,         "SELECT `button`, `action`, `type` FROM `character_action` WHERE `guid` = '%u' ORDER BY `button`", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSOCIALLIST,      "SELECT `friend`, `flags` FROM `character_social` WHERE `guid` = '%u' LIMIT 255", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADHOMEBIND,        "SELECT `map`, `zone`, `position_x`, `position_y`, `position_z` FROM `character_homebind` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSPELLCOOLDOWNS,  "SELECT `spell`, `spell_expire_time`, `category`, `category_expire_time`, `item_id` FROM `character_spell_cooldown` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADGUILD,           "SELECT `guild_id`, `rank` FROM `guild_member` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADBGDATA,          "SELECT `instance_id`, `team`, `join_x`, `join_y`, `join_z`, `join_o`, `join_map` FROM `character_battleground_data` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSKILLS,          "SELECT `skill`, `value`, `max` FROM `character_skills` WHERE `guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILS,           "SELECT `id`, `message_type`, `sender_guid`, `receiver_guid`, `subject`, `item_text_id`, `expire_time`, `deliver_time`, `money`, `cod`, `checked`, `stationery`, `mail_template_id`, `has_items` FROM `mail` WHERE `receiver_guid` = '%u' ORDER BY `id` DESC", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,     "SELECT `creator_guid`, `gift_creator_guid`, `count`, `duration`, `charges`, `flags`, `enchantments`, `random_property_id`, `durability`, `text`, `mail_id`, `item_guid`, `item_instance`.`item_id`, `generated_loot` FROM `mail_items` JOIN `item_instance` ON `item_guid` = `guid` WHERE `receiver_guid` = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_FORGOTTEN_SKILLS,    "SELECT `skill`, `value` FROM `character_forgotten_skills` WHERE `guid` = '%u'", m_guid.GetCounter());
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADFROM, loadFrom, "SELECT `guid`, `account`, `name`, `race`, `class`, `gender`, `level`, `xp`, `money`, `skin`, `face`, `hair_style`, `hair_color`, `facial_hair`, `bank_bag_slots`, `player_flags`, "
+                              "`position_x`, `position_y`, `position_z`, `map`, `orientation`, `known_taxi_mask`, `played_time_total`, `played_time_level`, `rest_bonus`, `logout_time`, `is_logout_resting`, `reset_talents_multiplier`, "
+                              "`reset_talents_time`, `transport_guid`, `transport_x`, `transport_y`, `transport_z`, `transport_o`, `extra_flags`, `stable_slots`, `at_login_flags`, `zone`, `online`, `death_expire_time`, `current_taxi_path`, "
+                              "`honor_rank_points`, `honor_highest_rank`, `honor_standing`, `honor_last_week_hk`, `honor_last_week_cp`, `honor_stored_hk`, `honor_stored_dk`, "
+                              "`watched_faction`, `drunk`, `health`, `power1`, `power2`, `power3`, `power4`, `power5`, `explored_zones`, `equipment_cache`, `ammo_id`, `action_bars`, "
+                              "`world_phase_mask`, `create_time` FROM `characters` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADGROUP, loadGroup, "SELECT `group_id` FROM `group_member` WHERE `member_guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADBOUNDINSTANCES, loadBoundInstances, "SELECT `id`, `permanent`, `map`, `reset_time` FROM `character_instance` LEFT JOIN `instance` ON `instance` = `id` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADAURAS, loadAuras, "SELECT `caster_guid`, `item_guid`, `spell`, `stacks`, `charges`, `base_points0`, `base_points1`, `base_points2`, `periodic_time0`, `periodic_time1`, `periodic_time2`, `max_duration`, `duration`, `effect_index_mask` FROM `character_aura` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADSPELLS, loadSpells, "SELECT `spell`, `active`, `disabled` FROM `character_spell` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADQUESTSTATUS, loadQuestStatus, "SELECT `quest`, `status`, `rewarded`, `explored`, `timer`, `mob_count1`, `mob_count2`, `mob_count3`, `mob_count4`, `item_count1`, `item_count2`, `item_count3`, `item_count4`, `reward_choice` FROM `character_queststatus` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADHONORCP, loadHonorCP, "SELECT `victim_type`, `victim_id`, `cp`, `date`, `type` FROM `character_honor_cp` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADREPUTATION, loadReputation, "SELECT `faction`, `standing`, `flags` FROM `character_reputation` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADINVENTORY, loadInventory, "SELECT * FROM (SELECT `creator_guid`, `gift_creator_guid`, `count`, `duration`, `charges`, `flags`, `enchantments`, `random_property_id`, `durability`, `text`, `bag`, `slot`, `item_guid`, `item_instance`.`item_id`, `generated_loot` FROM `character_inventory` JOIN `item_instance` ON `character_inventory`.`item_guid` = `item_instance`.`guid` WHERE `character_inventory`.`guid` = ?) as t ORDER BY `bag`, `slot`");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADITEMLOOT, loadItemLoot, "SELECT `guid`, `item_id`, `amount`, `property` FROM `item_loot` WHERE `owner_guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADACTIONS, loadActions, "SELECT `button`, `action`, `type` FROM `character_action` WHERE `guid` = ? ORDER BY `button`");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADSOCIALLIST, loadSocialList, "SELECT `friend`, `flags` FROM `character_social` WHERE `guid` = ? LIMIT 255");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADHOMEBIND, loadHomeBind, "SELECT `map`, `zone`, `position_x`, `position_y`, `position_z` FROM `character_homebind` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADSPELLCOOLDOWNS, loadSpellCooldowns, "SELECT `spell`, `spell_expire_time`, `category`, `category_expire_time`, `item_id` FROM `character_spell_cooldown` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADGUILD, loadGuild, "SELECT `guild_id`, `rank` FROM `guild_member` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADBGDATA, loadBGData, "SELECT `instance_id`, `team`, `join_x`, `join_y`, `join_z`, `join_o`, `join_map` FROM `character_battleground_data` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADSKILLS, loadSkills, "SELECT `skill`, `value`, `max` FROM `character_skills` WHERE `guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADMAILS, loadMails, "SELECT `id`, `message_type`, `sender_guid`, `receiver_guid`, `subject`, `item_text_id`, `expire_time`, `deliver_time`, `money`, `cod`, `checked`, `stationery`, `mail_template_id`, `has_items` FROM `mail` WHERE `receiver_guid` = ? ORDER BY `id` DESC");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS, loadMailedItems, "SELECT `creator_guid`, `gift_creator_guid`, `count`, `duration`, `charges`, `flags`, `enchantments`, `random_property_id`, `durability`, `text`, `mail_id`, `item_guid`, `item_instance`.`item_id`, `generated_loot` FROM `mail_items` JOIN `item_instance` ON `item_guid` = `guid` WHERE `receiver_guid` = ?");
+    res &= SetGuidStatement(PLAYER_LOGIN_QUERY_FORGOTTEN_SKILLS, loadForgottenSkills, "SELECT `skill`, `value` FROM `character_forgotten_skills` WHERE `guid` = ?");
 
     return res;
 }
@@ -125,6 +148,7 @@ public:
     void HandlePlayerLoginCallback(QueryResult* /*dummy*/, SqlQueryHolder * holder)
     {
         if (!holder) return;
+        sWorld.GetLoginQueriesLatency().Record(WorldTimer::getMSTimeDiffToNow(((LoginQueryHolder*)holder)->GetStartTime()));
         WorldSession* session = sWorld.FindSession(((LoginQueryHolder*)holder)->GetAccountId());
         if (!session)
         {
@@ -301,12 +325,12 @@ void WorldSession::HandleCharCreateOpcode(WorldPacket& recv_data)
 
     if (!AllowTwoSideAccounts)
     {
-        std::list<PlayerCacheData*> characters;
+        std::list<PlayerCacheDataPtr> characters;
         sObjectMgr.GetPlayerDataForAccount(GetAccountId(), characters);
 
         if (!characters.empty())
         {
-            PlayerCacheData* cData = characters.front();
+            PlayerCacheDataPtr cData = characters.front();
             Team team_ = Player::TeamForRace(race_);
 
             uint8 acc_race = cData->uiRace;
@@ -369,7 +393,7 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket& recv_data)
 
     uint32 lowguid = guid.GetCounter();
 
-    PlayerCacheData* cacheData = sObjectMgr.GetPlayerDataByGUID(lowguid);
+    PlayerCacheDataPtr cacheData = sObjectMgr.GetPlayerDataByGUID(lowguid);
     if (!cacheData)
         return; // Character not found
 
@@ -729,6 +753,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder *holder)
 
     m_playerLoading = false;
     m_clientMoverGuid = pCurrChar->GetObjectGuid();
+    sWorld.GetLoginLatency().Record(WorldTimer::getMSTimeDiffToNow(holder->GetStartTime()));
     delete holder;
     if (alreadyOnline)
     {
@@ -601,20 +601,17 @@ void WorldSession::SendStablePet(ObjectGuid guid)
         data << uint8(0x01);                                    // client slot 1 == current pet (0)
         ++num;
     }
-    CharPetMap const& pets = sCharacterDatabaseCache.GetCharPetsMap();
-    CharPetMap::const_iterator myPets = pets.find(GetPlayer()->GetGUIDLow());
-    if (myPets != pets.end())
-        for (const auto it : myPets->second)
-            if (it->slot >= PET_SAVE_FIRST_STABLE_SLOT && it->slot <= PET_SAVE_LAST_STABLE_SLOT)
-            {
-                data << uint32(it->id);                 // pet number
-                data << uint32(it->entry);              // creature entry
-                data << uint32(it->level);              // level
-                data << it->name;                       // name
-                data << uint32(it->loyalty);            // loyalty
-                data << uint8(it->slot + 1);            // slot
-                ++num;
-            }
+    for (const auto it : sCharacterDatabaseCache.GetCharacterPets(GetPlayer()->GetGUIDLow()))
+        if (it->slot >= PET_SAVE_FIRST_STABLE_SLOT && it->slot <= PET_SAVE_LAST_STABLE_SLOT)
+        {
+            data << uint32(it->id);                 // pet number
+            data << uint32(it->entry);              // creature entry
+            data << uint32(it->level);              // level
+            data << it->name;                       // name
+            data << uint32(it->loyalty);            // loyalty
+            data << uint8(it->slot + 1);            // slot
+            ++num;
+        }
 
     data.put<uint8>(wpos, num);                             // set real data to placeholder
     SendPacket(&data);
@@ -687,12 +684,9 @@ void WorldSession::HandleStablePet(WorldPacket& recv_data)
 
     // Find free slot for pet
     bool usedSlots[PET_SAVE_LAST_STABLE_SLOT - PET_SAVE_FIRST_STABLE_SLOT + 1] = {false};
-    CharPetMap const& pets = sCharacterDatabaseCache.GetCharPetsMap();
-    CharPetMap::const_iterator myPets = pets.find(GetPlayer()->GetGUIDLow());
-    if (myPets != pets.end())
-        for (const auto it : myPets->second)
-            if (it->slot >= PET_SAVE_FIRST_STABLE_SLOT && it->slot <= PET_SAVE_LAST_STABLE_SLOT)
-                usedSlots[it->slot - PET_SAVE_FIRST_STABLE_SLOT] = true;
+    for (const auto it : sCharacterDatabaseCache.GetCharacterPets(GetPlayer()->GetGUIDLow()))
+        if (it->slot >= PET_SAVE_FIRST_STABLE_SLOT && it->slot <= PET_SAVE_LAST_STABLE_SLOT)
+            usedSlots[it->slot - PET_SAVE_FIRST_STABLE_SLOT] = true;
 
     for (free_slot = PET_SAVE_FIRST_STABLE_SLOT; free_slot <= PET_SAVE_LAST_STABLE_SLOT && usedSlots[free_slot - PET_SAVE_FIRST_STABLE_SLOT]; ++free_slot);
 
@@ -57,7 +57,7 @@ void WorldSession::SendNameQueryOpcode(Player* p)
 void WorldSession::SendNameQueryOpcodeFromDB(ObjectGuid guid)
 {
     // Avec la mise en cache...
-    if (PlayerCacheData* pData = sObjectMgr.GetPlayerDataByGUID(guid.GetCounter()))
+    if (PlayerCacheDataPtr pData = sObjectMgr.GetPlayerDataByGUID(guid.GetCounter()))
     {
         std::string name = pData->sName;
 
@@ -19,6 +19,8 @@
 #include "InstanceStatistics.h"
 #include "Policies/Singleton.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SqlBatchWriter.h"
+#include "World.h"
 #include "Policies/SingletonImp.h"
 #include "Map.h"
 #include "Creature.h"
@@ -220,27 +222,31 @@ void InstanceStatisticsMgr::IncrementCustomCounter(eInstanceCustomCounter index,
 
     if (save)
     {
-        LogsDatabase.BeginTransaction();
-        LogsDatabase.PExecute("DELETE FROM `instance_custom_counters` WHERE `index` = %u", index);
-        LogsDatabase.PExecute("INSERT INTO `instance_custom_counters` (`index`, `count`) VALUES (%u, %u)", index, count);
-        LogsDatabase.CommitTransaction();
+        SqlBatchRow row(LogsDatabase);
+        row.addUInt32(index);
+        row.addUInt32(count);
+        sWorld.GetLogsWriter().Replace("REPLACE INTO `instance_custom_counters` (`index`, `count`) VALUES ", std::to_string(index), row);
     }
 }
 
 void InstanceStatisticsMgr::Save(uint32 mapId, uint32 creatureEntry, uint32 spellId, uint32 count)
 {
-    LogsDatabase.BeginTransaction();
-    LogsDatabase.PExecute("DELETE FROM `instance_creature_kills` WHERE `mapId` = %u and `creatureEntry` = %u and `spellEntry` = %u",
-        mapId, creatureEntry, spellId);
-    LogsDatabase.PExecute("INSERT INTO `instance_creature_kills` (`mapId`, `creatureEntry`, `spellEntry`, `count`) VALUES (%u, %u, %u, %u)",
-        mapId, creatureEntry, spellId, count);
-    LogsDatabase.CommitTransaction();
+    // the rows of a key replace each other until the batch is written
+    SqlBatchRow row(LogsDatabase);
+    row.addUInt32(mapId);
+    row.addUInt32(creatureEntry);
+    row.addUInt32(spellId);
+    row.addUInt32(count);
+    sWorld.GetLogsWriter().Replace("REPLACE INTO `instance_creature_kills` (`mapId`, `creatureEntry`, `spellEntry`, `count`) VALUES ",
+        std::to_string(mapId) + ':' + std::to_string(creatureEntry) + ':' + std::to_string(spellId), row);
 }
 
 void InstanceStatisticsMgr::Save(uint32 mapId, uint32 creatureEntry, uint32 count)
 {
-    LogsDatabase.BeginTransaction();
-    LogsDatabase.PExecute("DELETE FROM `instance_wipes` WHERE `mapId` = %u and `creatureEntry` = %u",  mapId, creatureEntry);
-    LogsDatabase.PExecute("INSERT INTO `instance_wipes` (`mapId`, `creatureEntry`, `count`) VALUES (%u, %u, %u)", mapId, creatureEntry, count);
-    LogsDatabase.CommitTransaction();
+    SqlBatchRow row(LogsDatabase);
+    row.addUInt32(mapId);
+    row.addUInt32(creatureEntry);
+    row.addUInt32(count);
+    sWorld.GetLogsWriter().Replace("REPLACE INTO `instance_wipes` (`mapId`, `creatureEntry`, `count`) VALUES ",
+        std::to_string(mapId) + ':' + std::to_string(creatureEntry), row);
 }
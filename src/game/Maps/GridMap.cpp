@@ -32,7 +32,7 @@
 #include "SQLStorages.h"
 
 char const* MAP_MAGIC         = "MAPS";
-char const* MAP_VERSION_MAGIC = "z1.4";
+char const* MAP_VERSION_MAGIC = "z1.5";
 char const* MAP_AREA_MAGIC    = "AREA";
 char const* MAP_HEIGHT_MAGIC  = "MHGT";
 char const* MAP_LIQUID_MAGIC  = "MLIQ";
@@ -53,7 +53,7 @@ GridMap::GridMap(): m_gridIntHeightMultiplier(0)
     m_gridGetHeight = &GridMap::getHeightFromFlat;
     m_V9 = nullptr;
     m_V8 = nullptr;
-    memset(m_holes, 0, sizeof(m_holes));
+    m_holes = nullptr;
 
     // Liquid data
     m_liquidGlobalEntry = 0;
@@ -78,66 +78,62 @@ bool GridMap::loadData(char const* filename)
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    if (!m_file.Open(filename))
         return true;
 
-    fread(&header, sizeof(header), 1, in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+    GridMapFileHeader header;
+    if (m_file.GetSize() >= sizeof(header))
+        memcpy(&header, m_file.GetData(), sizeof(header));
+    if (m_file.GetSize() >= sizeof(header) &&
+            header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
             header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup holes data
-        if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesOffset && !loadHolesData(header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadGridMapLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    m_file.Close();
 
+    m_holes = nullptr;
     m_area_map = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -147,59 +143,74 @@ void GridMap::unloadData()
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<class Header>
+bool GridMap::readSectionHeader(uint32 offset, uint32 size, char const* magic, Header& header, uint32& dataSize) const
+{
+    // The arrays are used in place, they must be aligned in the file
+    if (offset % MAP_SECTION_ALIGNMENT || size < sizeof(header) || uint64(offset) + size > m_file.GetSize())
+        return false;
+
+    memcpy(&header, m_file.GetData() + offset, sizeof(header));
+    if (header.fourcc != *((uint32 const*)(magic)))
+        return false;
+
+    dataSize = size - sizeof(header);
+    return true;
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 size)
 {
     GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    uint32 dataSize;
+    if (!readSectionHeader(offset, size, MAP_AREA_MAGIC, header, dataSize))
         return false;
 
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        fread(m_area_map, sizeof(uint16), 16 * 16, in);
+        if (dataSize < sizeof(uint16) * 16 * 16)
+            return false;
+        m_area_map = reinterpret_cast<uint16 const*>(m_file.GetData() + offset + sizeof(header));
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 size)
 {
     GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    uint32 dataSize;
+    if (!readSectionHeader(offset, size, MAP_HEIGHT_MAGIC, header, dataSize))
         return false;
 
+    unsigned char const* data = m_file.GetData() + offset + sizeof(header);
     m_gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
+            if (dataSize < sizeof(uint16) * (129 * 129 + 128 * 128))
+                return false;
+            m_uint16_V9 = reinterpret_cast<uint16 const*>(data);
+            m_uint16_V8 = m_uint16_V9 + 129 * 129;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
+            if (dataSize < sizeof(uint8) * (129 * 129 + 128 * 128))
+                return false;
+            m_uint8_V9 = data;
+            m_uint8_V8 = m_uint8_V9 + 129 * 129;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            fread(m_V9, sizeof(float), 129 * 129, in);
-            fread(m_V8, sizeof(float), 128 * 128, in);
+            if (dataSize < sizeof(float) * (129 * 129 + 128 * 128))
+                return false;
+            m_V9 = reinterpret_cast<float const*>(data);
+            m_V8 = m_V9 + 129 * 129;
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
     }
@@ -209,22 +220,20 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint32 offset, uint32 size)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (offset % MAP_SECTION_ALIGNMENT || size < sizeof(uint16) * 16 * 16 || uint64(offset) + size > m_file.GetSize())
         return false;
 
-    if (fread(&m_holes, sizeof(m_holes), 1, in) != 1)
-        return false;
+    m_holes = reinterpret_cast<uint16 const*>(m_file.GetData() + offset);
     return true;
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint32 offset, uint32 size)
 {
     GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    uint32 dataSize;
+    if (!readSectionHeader(offset, size, MAP_LIQUID_MAGIC, header, dataSize))
         return false;
 
     m_liquidGlobalEntry = header.liquidType;
@@ -235,19 +244,22 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     m_liquid_height = header.height;
     m_liquidLevel   = header.liquidLevel;
 
+    unsigned char const* data = m_file.GetData() + offset + sizeof(header);
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
-
-        m_liquidFlags = new uint8[16 * 16];
-        fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
+        if (dataSize < sizeof(uint16) * 16 * 16 + sizeof(uint8) * 16 * 16)
+            return false;
+        m_liquidEntry = reinterpret_cast<uint16 const*>(data);
+        m_liquidFlags = data + sizeof(uint16) * 16 * 16;
+        data += sizeof(uint16) * 16 * 16 + sizeof(uint8) * 16 * 16;
+        dataSize -= sizeof(uint16) * 16 * 16 + sizeof(uint8) * 16 * 16;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        if (dataSize < sizeof(float) * m_liquid_width * m_liquid_height)
+            return false;
+        m_liquid_map = reinterpret_cast<float const*>(data);
     }
 
     return true;
@@ -277,7 +289,10 @@ bool GridMap::isHole(int row, int col) const
     int holeRow = row % 8 / 2;
     int holeCol = (col - (cellCol * 8)) / 2;
 
-    uint16 hole = m_holes[cellRow][cellCol];
+    if (!m_holes)
+        return false;
+
+    uint16 hole = m_holes[cellRow * 16 + cellCol];
 
     return (hole & holetab_h[holeCol] & holetab_v[holeRow]) != 0;
 }
@@ -383,7 +398,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -451,7 +466,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
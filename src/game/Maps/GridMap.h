@@ -26,6 +26,7 @@
 #include "Maps/GridMapDefines.h"
 #include "Object.h"
 #include "SharedDefines.h"
+#include "MappedFile.h"
 #include <memory>
 #include <bitset>
 #include <list>
@@ -52,27 +53,30 @@ class GridMap
 {
     private:
 
-        uint16 m_holes[16][16];
+        // The arrays below point into the file, mapped when the system allows it
+        MappedFile m_file;
+
+        uint16 const* m_holes = nullptr;                    // [16][16]
         uint32 m_flags = 0;
 
         // Area data
         uint16 m_gridArea = 0;
-        uint16* m_area_map = nullptr;
+        uint16 const* m_area_map = nullptr;
 
         // Height level data
         float m_gridHeight = INVALID_HEIGHT_VALUE;
         float m_gridIntHeightMultiplier;
         union
         {
-            float* m_V9;
-            uint16* m_uint16_V9;
-            uint8* m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float* m_V8;
-            uint16* m_uint16_V8;
-            uint8* m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -83,14 +87,17 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint16* m_liquidEntry = nullptr;
-        uint8* m_liquidFlags = nullptr;
-        float* m_liquid_map = nullptr;
-
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        uint16 const* m_liquidEntry = nullptr;
+        uint8 const* m_liquidFlags = nullptr;
+        float const* m_liquid_map = nullptr;
+
+        // Header of a section, and the size of what follows it
+        template<class Header>
+        bool readSectionHeader(uint32 offset, uint32 size, char const* magic, Header& header, uint32& dataSize) const;
+        bool loadAreaData(uint32 offset, uint32 size);
+        bool loadHeightData(uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(uint32 offset, uint32 size);
+        bool loadHolesData(uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
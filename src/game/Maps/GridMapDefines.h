@@ -2,6 +2,9 @@
 #ifndef EXTRACTOR_DEFINES_H
 #define EXTRACTOR_DEFINES_H
 
+// Offset of each section in the file, so the arrays of a mapped file can be used in place
+#define MAP_SECTION_ALIGNMENT 16
+
 struct GridMapFileHeader
 {
     uint32 mapMagic;
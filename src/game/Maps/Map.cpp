@@ -51,7 +51,7 @@
 #include "MovementBroadcaster.h"
 #include "PlayerBroadcaster.h"
 #include "GridSearchers.h"
-#include "ThreadPool.h"
+#include "TaskScheduler.h"
 #include "AuraRemovalMgr.h"
 #include "world/world_event_wareffort.h"
 
@@ -128,7 +128,9 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
       m_updateFinished(false), m_updateDiffMod(0), m_GridActivationDistance(DEFAULT_VISIBILITY_DISTANCE),
       _lastPlayersUpdate(WorldTimer::getMSTime()), _lastMapUpdate(WorldTimer::getMSTime()),
       _lastCellsUpdate(WorldTimer::getMSTime()), _inactivePlayersSkippedUpdates(0),
-      _objUpdatesThreads(0), _unitRelocationThreads(0), _lastPlayerLeftTime(0),
+      _objUpdatesThreads(0), _unitRelocationThreads(0),
+      i_objectsToClientUpdate(sWorld.GetUpdateScheduler()), i_unitsRelocated(sWorld.GetUpdateScheduler()),
+      unitsMvtUpdate(sWorld.GetUpdateScheduler()), _lastPlayerLeftTime(0),
       m_lastMvtSpellsUpdate(0), _bonesCleanupTimer(0), m_uiScriptedEventsTimer(1000)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
@@ -156,14 +158,38 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
 
     if (IsContinent())
     {
-        m_motionThreads.reset(new ThreadPool(sWorld.getConfig(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS)));
-        m_objectThreads.reset(new ThreadPool(std::max((int)sWorld.getConfig(CONFIG_UINT32_MAP_OBJECTSUPDATE_THREADS) -1,0)));
-        m_visibilityThreads.reset(new ThreadPool(std::max((int)sWorld.getConfig(CONFIG_UINT32_MAP_VISIBILITYUPDATE_THREADS) -1,0)));
-        m_cellThreads.reset(new ThreadPool(std::max((int)sWorld.getConfig(CONFIG_UINT32_MTCELLS_THREADS) - 1, 0)));
-        m_visibilityThreads->start<ThreadPool::MySQL<ThreadPool::MultiQueue>>();
-        m_cellThreads->start();
-        m_motionThreads->start();
-        m_objectThreads->start<ThreadPool::MySQL<ThreadPool::MultiQueue>>();
+        m_motionUpdateTasks = sWorld.getConfig(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS);
+        m_objectUpdateTasks = sWorld.getConfig(CONFIG_UINT32_MAP_OBJECTSUPDATE_THREADS);
+        m_visibilityUpdateTasks = sWorld.getConfig(CONFIG_UINT32_MAP_VISIBILITYUPDATE_THREADS);
+        m_cellUpdateTasks = sWorld.getConfig(CONFIG_UINT32_MTCELLS_THREADS);
+
+        // Higher world X gives lower cell coordinates
+        for (float bound : sWorld.GetContinentRegionBounds(GetId()))
+            m_regionCellBounds.push_back(MaNGOS::ComputeCellPair(bound, 0.0f).x_coord);
+        std::sort(m_regionCellBounds.begin(), m_regionCellBounds.end());
+        m_regionCellBounds.erase(std::unique(m_regionCellBounds.begin(), m_regionCellBounds.end()), m_regionCellBounds.end());
+        m_regionSafeCells = sWorld.getConfig(CONFIG_UINT32_MTCELLS_SAFEDISTANCE) / SIZE_OF_GRID_CELL + 1;
+
+        if (!m_regionCellBounds.empty())
+        {
+            m_cellRegions.resize(TOTAL_NUMBER_OF_CELLS_PER_MAP);
+            for (uint32 x = 0; x < TOTAL_NUMBER_OF_CELLS_PER_MAP; ++x)
+            {
+                int region = 0;
+                for (uint32 bound : m_regionCellBounds)
+                {
+                    if (x + m_regionSafeCells > bound && x < bound + m_regionSafeCells)
+                    {
+                        region = REGION_BORDER;
+                        break;
+                    }
+                    if (x >= bound)
+                        ++region;
+                }
+                m_cellRegions[x] = region;
+            }
+            m_regionCells.resize(m_regionCellBounds.size() + 2);
+        }
     }
 
     LoadElevatorTransports();
@@ -769,18 +795,134 @@ inline void Map::UpdateActiveCellsAsynch(uint32 now, uint32 diff)
     for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end(); ++m_activeNonPlayersIter)
         MarkCellsAroundObject(*m_activeNonPlayersIter);
 
-    const int nthreads = m_cellThreads->size();
+    TaskScheduler* scheduler = sWorld.GetUpdateScheduler();
+    const int nthreads = m_cellUpdateTasks - 1;
     for (int step = 0; step < 2; step++)
     {
+        TaskScheduler::TaskGroup cells;
         for (int i = 0; i < nthreads; ++i)
-            m_cellThreads << [this, diff, now, i, nthreads](){
+            scheduler->spawn(cells, [this, diff, now, i, nthreads](){
                 UpdateActiveCellsCallback(diff, now, i, nthreads+1, 0);
-            };
-        std::future<void> job = m_cellThreads->processWorkload();
+            });
         UpdateActiveCellsCallback(diff, now, nthreads, nthreads+1, 0);
-        if (job.valid())
-            job.wait();
+        scheduler->wait(cells);
+    }
+}
+
+namespace
+{
+    // Region updated by the current thread, if any
+    thread_local Map const* t_regionMap = nullptr;
+    thread_local int t_region = -1;
+}
+
+int Map::GetCellRegion(uint32 cellX) const
+{
+    return m_cellRegions[cellX];
+}
+
+inline void Map::MarkRegionCellsAroundObject(WorldObject const* object)
+{
+    if (!object || !object->IsInWorld() || !object->IsPositionValid())
+        return;
+
+    CellArea area = Cell::CalculateCellArea(object->GetPositionX(), object->GetPositionY(), GetGridActivationDistance());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        int const region = GetCellRegion(x);
+        std::vector<uint32>& cells = m_regionCells[region == REGION_BORDER ? m_regionCells.size() - 1 : region];
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id))
+                continue;
+            markCell(cell_id);
+            cells.push_back(cell_id);
+        }
+    }
+}
+
+void Map::UpdateRegionCells(uint32 diff, uint32 now, int region)
+{
+    MaNGOS::ObjectUpdater updater(diff, now);
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    if (region != REGION_BORDER)
+    {
+        t_regionMap = this;
+        t_region = region;
+    }
+
+    for (uint32 cellId : m_regionCells[region == REGION_BORDER ? m_regionCells.size() - 1 : region])
+    {
+        CellPair pair(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
+
+    t_regionMap = nullptr;
+    t_region = REGION_BORDER;
+}
+
+inline void Map::UpdateActiveCellsByRegion(uint32 now, uint32 diff)
+{
+    resetMarkedCells();
+    for (std::vector<uint32>& cells : m_regionCells)
+        cells.clear();
+
+    // Mark all cells that need update, and list them by region
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        MarkRegionCellsAroundObject(m_mapRefIter->getSource());
+
+    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end(); ++m_activeNonPlayersIter)
+        MarkRegionCellsAroundObject(*m_activeNonPlayersIter);
+
+    TaskScheduler* scheduler = sWorld.GetUpdateScheduler();
+    TaskScheduler::TaskGroup regions;
+    int const regionsCount = m_regionCellBounds.size() + 1;
+    for (int region = 1; region < regionsCount; ++region)
+        scheduler->spawn(regions, [this, diff, now, region]() {
+            UpdateRegionCells(diff, now, region);
+        });
+    UpdateRegionCells(diff, now, 0);
+    scheduler->wait(regions);
+
+    // Nothing else runs now, the border cells and the handoffs are safe to process
+    UpdateRegionCells(diff, now, REGION_BORDER);
+    ProcessRegionHandoffs();
+}
+
+bool Map::DeferRegionHandoff(Creature* creature, Cell const& new_cell, float x, float y, float z, float ang)
+{
+    if (t_regionMap != this)
+        return false;
+
+    // Only the cells of our own region are ours. The border cells are updated
+    // after the barrier and an other region may move into them too.
+    if (GetCellRegion(new_cell.cellPair().x_coord) == t_region)
+        return false;
+
+    std::unique_lock<std::mutex> lock(m_regionHandoffs_lock);
+    m_regionHandoffs.push_back({ creature->GetObjectGuid(), x, y, z, ang });
+    return true;
+}
+
+void Map::ProcessRegionHandoffs()
+{
+    std::vector<RegionHandoff> handoffs;
+    {
+        std::unique_lock<std::mutex> lock(m_regionHandoffs_lock);
+        handoffs.swap(m_regionHandoffs);
     }
+
+    for (RegionHandoff const& handoff : handoffs)
+        if (Creature* creature = GetCreature(handoff.guid))
+            if (creature->IsInWorld())
+                CreatureRelocation(creature, handoff.x, handoff.y, handoff.z, handoff.o);
 }
 
 inline void Map::UpdateActiveCellsSynch(uint32 now, uint32 diff)
@@ -817,21 +959,27 @@ inline void Map::UpdateCells(uint32 map_diff)
     _lastCellsUpdate = now;
 
     /// update active cells around players and active objects
-    if (IsContinent() && m_cellThreads->status() == ThreadPool::Status::READY)
+    if (!m_regionCellBounds.empty())
+        UpdateActiveCellsByRegion(now, diff);
+    else if (m_cellUpdateTasks > 1)
         UpdateActiveCellsAsynch(now, diff);
     else
         UpdateActiveCellsSynch(now, diff);
 
-    if (IsContinent() && m_motionThreads->status() == ThreadPool::Status::READY && !unitsMvtUpdate.empty())
+    std::vector<WorldObject*> const& movingUnits = unitsMvtUpdate.Collect();
+    if (m_motionUpdateTasks && !movingUnits.empty())
     {
-        for (std::set<Unit*>::iterator it = unitsMvtUpdate.begin(); it != unitsMvtUpdate.end(); it++)
-            m_motionThreads << [it,diff](){
-                 if ((*it)->IsInWorld())
-                    (*it)->GetMotionMaster()->UpdateMotionAsync(diff);
-            };
-        m_motionThreads->processWorkload().wait();
+        TaskScheduler* scheduler = sWorld.GetUpdateScheduler();
+        TaskScheduler::TaskGroup motions;
+        for (WorldObject* object : movingUnits)
+            scheduler->spawn(motions, [object, diff](){
+                Unit* unit = static_cast<Unit*>(object);
+                if (unit->IsInWorld())
+                    unit->GetMotionMaster()->UpdateMotionAsync(diff);
+            });
+        scheduler->wait(motions);
     }
-    unitsMvtUpdate.clear();
+    unitsMvtUpdate.Clear();
 }
 
 
@@ -963,7 +1111,7 @@ void Map::Update(uint32 t_diff)
     {
         additionnalWaitTime = WorldTimer::getMSTime();
         sMapMgr.MarkContinentUpdateFinished();
-        while (!sMapMgr.waitContinentUpdateFinishedUntil(start + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))))
+        while (!sMapMgr.waitStartedContinentUpdatesFinishedUntil(start + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))))
         {
             start = std::chrono::high_resolution_clock::now();
             UpdateSessionsMovementAndSpellsIfNeeded();
@@ -1011,6 +1159,7 @@ void Map::Update(uint32 t_diff)
                  sessionsUpdateTime, playersUpdateTime, activeCellsUpdateTime, objectsUpdateTime,
                  visibilityUpdateTime, playersUpdateTime2, additionnalUpdateCounts, additionnalWaitTime,
                 packetBroadcastSlow ? "SLOWBCAST" : "");
+    UpdateTickInterval(updateMapTime);
     // Continent only
     if (IsContinent())
     {
@@ -1344,6 +1493,8 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
     bool same_cell = (new_cell == old_cell);
 
     player->Relocate(x, y, z, orientation);
+    if (player->m_broadcaster)
+        player->m_broadcaster->SetPosition(x, y);
 
     if (old_cell.DiffGrid(new_cell) || old_cell.DiffCell(new_cell))
     {
@@ -1421,6 +1572,10 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
 
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
+    // an other region is being updated there, move at the end of the regions update
+    if (DeferRegionHandoff(creature, new_cell, x, y, z, ang))
+        return;
+
     // do move or do move to respawn or remove creature if previous all fail
     if (CreatureCellRelocation(creature, new_cell))
     {
@@ -1600,7 +1755,7 @@ void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair)
 
 void Map::UpdateActiveObjectVisibility(Player* player)
 {
-    // Params for compressed data set - will only be compressed if packet size > 100 (multiple units)
+    // Params for compressed data set - will only be compressed if packet size > Compression.Threshold (multiple units)
     ObjectGuidSet guids;
     UpdateData data;
     std::set<WorldObject*> visibleNow;
@@ -2724,42 +2879,36 @@ void Map::AddUpdateObject(Object *obj)
 {
     if (_processingSendObjUpdates)
         return;
-    std::unique_lock<std::mutex> lock(i_objectsToClientUpdate_lock);
-    i_objectsToClientUpdate.insert(obj);
+    i_objectsToClientUpdate.Add(obj);
 }
 
 void Map::RemoveUpdateObject(Object *obj)
 {
     ASSERT(!_processingSendObjUpdates);
-    std::unique_lock<std::mutex> lock(i_objectsToClientUpdate_lock);
-    i_objectsToClientUpdate.erase( obj );
+    i_objectsToClientUpdate.Remove(obj);
 }
 
 void Map::AddRelocatedUnit(Unit *obj)
 {
     if (_processingUnitsRelocation)
         return;
-    std::unique_lock<std::mutex> lock(i_unitsRelocated_lock);
-    i_unitsRelocated.insert(obj);
+    i_unitsRelocated.Add(obj);
 }
 
 void Map::RemoveRelocatedUnit(Unit *obj)
 {
     ASSERT(!_processingUnitsRelocation);
-    std::unique_lock<std::mutex> lock(i_unitsRelocated_lock);
-    i_unitsRelocated.erase(obj);
+    i_unitsRelocated.Remove(obj);
 }
 
 void Map::AddUnitToMovementUpdate(Unit *unit)
 {
-    std::unique_lock<std::mutex> lock(unitsMvtUpdate_lock);
-    unitsMvtUpdate.insert(unit);
+    unitsMvtUpdate.Add(unit);
 }
 
 void Map::RemoveUnitFromMovementUpdate(Unit *unit)
 {
-    std::unique_lock<std::mutex> lock(unitsMvtUpdate_lock);
-    unitsMvtUpdate.erase(unit);
+    unitsMvtUpdate.Remove(unit);
 }
 
 
@@ -2770,15 +2919,17 @@ void Map::SendObjectUpdates()
     // VERY HEAVY LOAD in case of a lot of players at the same place
     // ~2ms / object if 500 players in the visible area around
     uint32 now = WorldTimer::getMSTime();
-    uint32 objectsCount = i_objectsToClientUpdate.size();
+    std::vector<Object*> const& t = i_objectsToClientUpdate.Collect();
+    uint32 objectsCount = t.size();
     if (!objectsCount)
+    {
+        i_objectsToClientUpdate.Clear();
         return;
+    }
     _processingSendObjUpdates = true;
 
     // Compute maximum number of threads
-    uint32 threads = 1;
-    if (IsContinent())
-        threads = m_objectThreads->size() +1;
+    uint32 threads = m_objectUpdateTasks;
     if (!_objUpdatesThreads)
         _objUpdatesThreads = 1;
     if (threads < _objUpdatesThreads)
@@ -2790,10 +2941,6 @@ void Map::SendObjectUpdates()
     ASSERT(step > 0);
     ASSERT(threads >= 1);
 
-    std::vector<std::set<Object*>::iterator> t;
-    t.reserve(i_objectsToClientUpdate.size()); //t will not contain end!
-    for (std::set<Object*>::iterator it = i_objectsToClientUpdate.begin(); it != i_objectsToClientUpdate.end(); it++)
-        t.push_back(it);
     std::atomic<int> ait(0);
     uint32 timeout = sWorld.getConfig(CONFIG_UINT32_MAP_OBJECTSUPDATE_TIMEOUT);
     auto f = [&t, &ait, beginTime=now, timeout](){
@@ -2801,7 +2948,7 @@ void Map::SendObjectUpdates()
         int it = ait++;
         while (it < t.size())
         {
-            (*t[it])->BuildUpdateData(update_players);
+            t[it]->BuildUpdateData(update_players);
             if (WorldTimer::getMSTimeDiffToNow(beginTime) > timeout)
                 break;
             it = ait++;
@@ -2810,19 +2957,21 @@ void Map::SendObjectUpdates()
         for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
             iter->second.Send(iter->first->GetSession());
     };
-    std::future<void> job;
-    if (m_objectThreads)
-         job = m_objectThreads->processWorkload();
+    TaskScheduler* scheduler = sWorld.GetUpdateScheduler();
+    TaskScheduler::TaskGroup updaters;
+    for (uint32 i = 0; i < threads - 1; ++i)
+        scheduler->spawn(updaters, f);
     f();
-    if (job.valid())
-        job.wait();
-    if (ait >= i_objectsToClientUpdate.size()) //ait is increased before checks, so max value is `objectsCount + threads`
-        i_objectsToClientUpdate.clear();
-    else
-        i_objectsToClientUpdate.erase(t.front(), t[ait]);
+    scheduler->wait(updaters);
+    // Objects not processed before the timeout are kept for the next update
+    uint32 processed = std::min<uint32>(ait, objectsCount); //ait is increased before checks, so max value is `objectsCount + threads`
+    std::vector<Object*> remaining(t.begin() + processed, t.end());
+    i_objectsToClientUpdate.Clear();
+    for (Object* obj : remaining)
+        i_objectsToClientUpdate.Add(obj);
 
     // If we timeout, use more threads !
-    if (!i_objectsToClientUpdate.empty())
+    if (!remaining.empty())
         ++_objUpdatesThreads;
     else
         --_objUpdatesThreads;
@@ -2831,7 +2980,7 @@ void Map::SendObjectUpdates()
 #ifdef MAP_SENDOBJECTUPDATES_PROFILE
     uint32 diff = WorldTimer::getMSTimeDiffToNow(now);
     if (diff > 50)
-        sLog.outString("SendObjectUpdates in %04u ms [%u threads. %3u/%3u]", diff, threads, objectsCount - i_objectsToClientUpdate.size(), objectsCount);
+        sLog.outString("SendObjectUpdates in %04u ms [%u threads. %3u/%3u]", diff, threads, processed, objectsCount);
 #endif
 }
 
@@ -2841,15 +2990,17 @@ void Map::UpdateVisibilityForRelocations()
 {
     // VERY HEAVY LOAD in case of a lot of players at the same place
     uint32 now = WorldTimer::getMSTime();
-    uint32 objectsCount = i_unitsRelocated.size();
+    std::vector<WorldObject*> const& t = i_unitsRelocated.Collect();
+    uint32 objectsCount = t.size();
     if (!objectsCount)
+    {
+        i_unitsRelocated.Clear();
         return;
+    }
     _processingUnitsRelocation = true;
 
     // Compute number of threads to spawn
-    uint32 threads = 1;
-    if (IsContinent())
-        threads = m_visibilityThreads->size() + 1;
+    uint32 threads = m_visibilityUpdateTasks;
     if (!_unitRelocationThreads)
         _unitRelocationThreads = 1;
     if (threads < _unitRelocationThreads)
@@ -2860,38 +3011,32 @@ void Map::UpdateVisibilityForRelocations()
     
     ASSERT(step > 0);
 
-    std::vector<std::set<Unit*>::iterator> t;
-    t.reserve(i_unitsRelocated.size());
-    for (std::set<Unit*>::iterator it = i_unitsRelocated.begin(); it != i_unitsRelocated.end(); it++)
-        t.emplace_back(it);
     std::atomic<int> ait(0);
     uint32 timeout = sWorld.getConfig(CONFIG_UINT32_MAP_VISIBILITYUPDATE_TIMEOUT);
     auto f = [&t, &ait, beginTime=now, timeout](){
         int it = ait++;
         while (it < t.size())
         {
-            (*t[it])->ProcessRelocationVisibilityUpdates();
+            static_cast<Unit*>(t[it])->ProcessRelocationVisibilityUpdates();
             if (WorldTimer::getMSTimeDiffToNow(beginTime) > timeout)
                 break;
             it = ait++;
         }
     };
-    for (uint32 i = 0; i < threads -1; ++i)
-        m_visibilityThreads << f;
-
-    std::future<void> job;
-    if (m_visibilityThreads)
-        job = m_visibilityThreads->processWorkload();
+    TaskScheduler* scheduler = sWorld.GetUpdateScheduler();
+    TaskScheduler::TaskGroup updaters;
+    for (uint32 i = 0; i < threads - 1; ++i)
+        scheduler->spawn(updaters, f);
 
     f();
-    if (job.valid())
-        job.wait();
-    if (ait >= i_unitsRelocated.size()) //ait is increased before checks, so max value is `objectsCount + threads`
-        i_unitsRelocated.clear();
-    else
-        i_unitsRelocated.erase(t.front(), t[ait]);
-
-    if (!i_unitsRelocated.empty())
+    scheduler->wait(updaters);
+    uint32 processed = std::min<uint32>(ait, objectsCount); //ait is increased before checks, so max value is `objectsCount + threads`
+    std::vector<WorldObject*> remaining(t.begin() + processed, t.end());
+    i_unitsRelocated.Clear();
+    for (WorldObject* unit : remaining)
+        i_unitsRelocated.Add(unit);
+
+    if (!remaining.empty())
         ++_unitRelocationThreads;
     else
         --_unitRelocationThreads;
@@ -2901,7 +3046,7 @@ void Map::UpdateVisibilityForRelocations()
 #ifdef MAP_UPDATEVISIBILITY_PROFILE
     uint32 diff = WorldTimer::getMSTimeDiffToNow(now);
     if (diff > 50)
-        sLog.outString("VisibilityUpdate in %04u ms [%u threads/done %u/%u]", diff, threads, objectsCount - i_unitsRelocated.size(), objectsCount);
+        sLog.outString("VisibilityUpdate in %04u ms [%u threads/done %u/%u]", diff, threads, processed, objectsCount);
 #endif
 }
 
@@ -3330,6 +3475,42 @@ void Map::PrintInfos(ChatHandler& handler)
     handler.PSendSysMessage("%u objects relocated [%u threads]", i_unitsRelocated.size(), _unitRelocationThreads);
     handler.PSendSysMessage("%u scripts scheduled", m_scriptSchedule.size());
     handler.PSendSysMessage("Vis:%.1f Act:%.1f", m_VisibleDistance, m_GridActivationDistance);
+    handler.PSendSysMessage("Tick interval %ums, avg update %ums", std::max(m_tickInterval, sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE)), m_updateTimeAvg);
+    handler.PSendSysMessage("Values blocks: %u built, %u reused (%u bytes)", uint32(m_valuesBlocksBuilt), uint32(m_valuesBlocksShared), uint32(m_valuesBytesShared));
+}
+
+bool Map::IsQuiet() const
+{
+    if (GetPlayersCountExceptGMs() >= sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_ADAPTIVE_DENSE_PLAYERS))
+        return false;
+
+    for (const auto& itr : m_mapRefManager)
+    {
+        Player const* player = itr.getSource();
+        if (player->IsInCombat() ||
+            player->GetSession()->HasRecentPacket(PACKET_PROCESS_SPELLS) ||
+            player->GetSession()->HasRecentPacket(PACKET_PROCESS_MOVEMENT))
+            return false;
+    }
+    return m_mScriptedEvents.empty();
+}
+
+void Map::UpdateTickInterval(uint32 updateTime)
+{
+    m_updateTimeAvg = (m_updateTimeAvg * 7 + updateTime) / 8;
+
+    uint32 const minInterval = sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE);
+    uint32 const maxInterval = sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_ADAPTIVE_MAX_INTERVAL);
+    uint32 interval = 0;
+    // Continents, battlegrounds and busy instances are updated at every tick.
+    // Quiet ones slow down progressively, and are back to full rate at their next update once active.
+    if (maxInterval > minInterval && Instanceable() && !IsBattleGround() && IsQuiet())
+        interval = std::min(maxInterval, std::max(m_tickInterval, minInterval) * 2);
+
+    if (interval != m_tickInterval && sWorld.getConfig(CONFIG_BOOL_PERFLOG_MAP_TICK_INTERVAL))
+        sLog.out(LOG_PERFORMANCE, "Map %u inst %u: tick interval %ums (avg update %ums, %u players)",
+            GetId(), GetInstanceId(), std::max(interval, minInterval), m_updateTimeAvg, GetPlayersCountExceptGMs());
+    m_tickInterval = interval;
 }
 
 bool Map::ShouldUpdateMap(uint32 now, uint32 inactiveTimeLimit)
@@ -43,6 +43,7 @@
 #include <list>
 #include <set>
 #include <mutex>
+#include <atomic>
 #include <shared_mutex>
 
 using Movement::Vector3;
@@ -314,8 +315,6 @@ struct ScriptedEvent
     ScriptedEvent(ScriptedEvent const&) = delete;
 };
 
-class ThreadPool;
-
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
@@ -353,6 +352,9 @@ class Map : public GridRefManager<NGridType>
         inline void MarkCellsAroundObject(WorldObject const* object);
         inline void UpdateActiveCellsAsynch(uint32 now, uint32 diff);
         inline void UpdateActiveCellsCallback(uint32 diff, uint32 now, uint32 threadId, uint32 totalThreads, uint32 step);
+        inline void MarkRegionCellsAroundObject(WorldObject const* object);
+        inline void UpdateActiveCellsByRegion(uint32 now, uint32 diff);
+        void UpdateRegionCells(uint32 diff, uint32 now, int region);
         inline void UpdateCells(uint32 diff);
         void UpdateSync(uint32 const);
         void UpdatePlayers();
@@ -592,6 +594,19 @@ class Map : public GridRefManager<NGridType>
         GameObject* SummonGameObject(uint32 entry, float x, float y, float z, float ang, float rotation0, float rotation1, float rotation2, float rotation3, uint32 respawnTime, uint32 worldMask);
 
         bool ShouldUpdateMap(uint32 now, uint32 inactiveTimeLimit);
+
+        // Adaptive tick rate: quiet instances are updated less often, at most every MapUpdate.Adaptive.MaxInterval
+        uint32 GetTickInterval() const { return m_tickInterval; }
+        uint32 GetAverageUpdateTime() const { return m_updateTimeAvg; }
+        bool IsTickDue(uint32 now) const { return WorldTimer::getMSTimeDiff(_lastMapUpdate, now) >= m_tickInterval; }
+
+        // Values update blocks built once and reused for other observers, see ValuesUpdateCache
+        void AddValuesUpdateStats(ValuesUpdateCache const& cache)
+        {
+            m_valuesBlocksBuilt += cache.builtBlocks;
+            m_valuesBlocksShared += cache.sharedBlocks;
+            m_valuesBytesShared += cache.sharedBytes;
+        }
         void RemoveBones(Corpse* corpse);
 
     private:
@@ -606,6 +621,11 @@ class Map : public GridRefManager<NGridType>
 
         bool CreatureCellRelocation(Creature* creature, Cell const& new_cell);
 
+        // Continent region sharding
+        int GetCellRegion(uint32 cellX) const;
+        bool DeferRegionHandoff(Creature* creature, Cell const& new_cell, float x, float y, float z, float ang);
+        void ProcessRegionHandoffs();
+
         bool loaded(GridPair const&) const;
         void EnsureGridCreated(GridPair const&);
         bool EnsureGridLoaded(Cell const&);
@@ -636,16 +656,14 @@ class Map : public GridRefManager<NGridType>
 
         bool                    _processingSendObjUpdates = false;
         uint32                  _objUpdatesThreads = 0;
-        mutable std::mutex              i_objectsToClientUpdate_lock;
-        std::set<Object *>      i_objectsToClientUpdate;
+        DirtyList<Object, &Object::m_clientUpdateSlot> i_objectsToClientUpdate;
 
         bool                    _processingUnitsRelocation = false;
         uint32                  _unitRelocationThreads = 0;
-        mutable std::mutex    i_unitsRelocated_lock;
-        std::set<Unit* >        i_unitsRelocated;
+        // Units only, stored as WorldObject since Unit is incomplete here
+        DirtyList<WorldObject, &WorldObject::m_relocatedSlot> i_unitsRelocated;
 
-        mutable std::mutex    unitsMvtUpdate_lock;
-        std::set<Unit*>         unitsMvtUpdate;
+        DirtyList<WorldObject, &WorldObject::m_movementUpdateSlot> unitsMvtUpdate;
 
         mutable MapMutexType    _corpseRemovalLock;
         typedef std::list<std::pair<Corpse*, ObjectGuid>> CorpseRemoveList;
@@ -658,10 +676,38 @@ class Map : public GridRefManager<NGridType>
         void RemoveCorpses(bool unload = false);
         void RemoveOldBones(uint32 const diff);
 
-        std::unique_ptr<ThreadPool> m_objectThreads;
-        std::unique_ptr<ThreadPool> m_motionThreads;
-        std::unique_ptr<ThreadPool> m_visibilityThreads;
-        std::unique_ptr<ThreadPool> m_cellThreads;
+        bool IsQuiet() const;
+        void UpdateTickInterval(uint32 updateTime);
+        uint32 m_tickInterval = 0;
+        uint32 m_updateTimeAvg = 0;
+
+        std::atomic<uint64> m_valuesBlocksBuilt{0};
+        std::atomic<uint64> m_valuesBlocksShared{0};
+        std::atomic<uint64> m_valuesBytesShared{0};
+
+        // Continents split into regions: bands of cells along the X axis, each one
+        // updated by its own task. Cells closer than MTCells.SafeDistance to a
+        // boundary are updated afterwards on the map thread. A creature moving out
+        // of its region (border cells included) during the parallel step is
+        // relocated at the barrier.
+        struct RegionHandoff
+        {
+            ObjectGuid guid;
+            float x, y, z, o;
+        };
+        static int const REGION_BORDER = -1;
+        std::vector<uint32>     m_regionCellBounds;
+        uint32                  m_regionSafeCells = 1;
+        std::vector<int>        m_cellRegions;              // region of each cell column
+        std::vector<std::vector<uint32>> m_regionCells;     // marked cells of each region, the border cells last
+        std::mutex              m_regionHandoffs_lock;
+        std::vector<RegionHandoff> m_regionHandoffs;
+
+        // Maximum number of scheduler tasks each update step is split into (continents only)
+        uint32 m_objectUpdateTasks = 1;
+        uint32 m_motionUpdateTasks = 0;
+        uint32 m_visibilityUpdateTasks = 1;
+        uint32 m_cellUpdateTasks = 0;
 
     protected:
         MapEntry const* i_mapEntry;
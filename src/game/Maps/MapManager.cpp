@@ -31,7 +31,7 @@
 #include "Group.h"
 #include "ZoneScriptMgr.h"
 #include "Map.h"
-#include "ThreadPool.h"
+#include "TaskScheduler.h"
 
 typedef MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex> MapManagerLock;
 INSTANTIATE_SINGLETON_2(MapManager, MapManagerLock);
@@ -40,11 +40,9 @@ INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
 MapManager::MapManager()
     :
     i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)),
-    i_MaxInstanceId(RESERVED_INSTANCES_LAST),
-    m_threads(new ThreadPool(sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_INSTANCED_UPDATE_THREADS)))
+    i_MaxInstanceId(RESERVED_INSTANCES_LAST)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
-    m_threads->start<ThreadPool::MySQL<>>();
 }
 
 MapManager::~MapManager()
@@ -249,8 +247,9 @@ void MapManager::Update(uint32 diff)
     uint32 now = WorldTimer::getMSTime();
 
     uint32 inactiveTimeLimit = sWorld.getConfig(CONFIG_UINT32_EMPTY_MAPS_UPDATE_TIME);
-    std::vector<std::function<void()>> continentsUpdaters;
-    std::vector<std::function<void()>> instancesUpdaters;
+    std::vector<TaskScheduler::Callable> continentsUpdaters;
+    std::vector<TaskScheduler::Callable> instancesUpdaters;
+    std::vector<Map*> instances;
 
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
     {
@@ -262,52 +261,60 @@ void MapManager::Update(uint32 diff)
         iter->second->MarkNotUpdated();
         if (iter->second->Instanceable())
         {
-            if (m_threads->status() == ThreadPool::Status::READY)
-                instancesUpdaters.emplace_back([iter,mapsDiff](){
-                    iter->second->DoUpdate(mapsDiff);
-                });
-            else
-                iter->second->DoUpdate(mapsDiff);
+            instances.push_back(iter->second);
         }
-        else // One threat per continent part
+        else // One task per continent part
         {
             continentsUpdaters.emplace_back([iter,mapsDiff](){
                 Map *m = iter->second;
                 if (!m->IsUpdateFinished() || !sMapMgr.IsContinentUpdateFinished())
+                {
+                    sMapMgr.MarkContinentUpdateStarted();
                     m->DoUpdate(mapsDiff);
+                }
             });
             continentsIdx++;
         }
     }
     i_maxContinentThread = continentsIdx;
 
+    // Most expensive instances first, so that they do not end last alone on a worker
+    std::sort(instances.begin(), instances.end(), [](Map const* a, Map const* b) {
+        return a->GetAverageUpdateTime() > b->GetAverageUpdateTime();
+    });
+    for (Map* map : instances)
+        instancesUpdaters.emplace_back([map,mapsDiff](){
+            // Quiet instances skip ticks, the diff covers the whole skipped time
+            if (map->IsTickDue(WorldTimer::getMSTime()))
+                map->DoUpdate(std::max(mapsDiff, map->GetTickInterval()));
+        });
+
+    i_continentUpdateStarted.store(0);
     i_continentUpdateFinished.store(0);
 
-    if (!m_continentThreads || m_continentThreads->size() < continentsUpdaters.size())
-    {
-        m_continentThreads.reset(new ThreadPool(continentsUpdaters.size()));
-        m_continentThreads->start<>();
-    }
-    std::future<void> continents = m_continentThreads->processWorkload(std::move(continentsUpdaters),
-                                                                       ThreadPool::Callable());
+    // Continent parts wait for each others at the end of their update, but only for
+    // the ones already started: with fewer free workers than continents, a continent
+    // still queued is run once a worker is free, or by this thread in wait().
+    TaskScheduler* scheduler = sWorld.GetUpdateScheduler();
+    TaskScheduler::TaskGroup continents;
+    for (auto& updater : continentsUpdaters)
+        scheduler->spawn(continents, std::move(updater));
 
     SwitchPlayersInstances();
 
     std::chrono::high_resolution_clock::time_point start;
     do {
         start = std::chrono::high_resolution_clock::now();
-        std::future<void> f = m_threads->processWorkload(instancesUpdaters,
-                                                         ThreadPool::Callable());
-
-        if (f.valid())
-            f.wait();
-        else
+        if (instancesUpdaters.empty())
             break;
-    }while(!sMapMgr.waitContinentUpdateFinishedUntil(start + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))));
 
+        TaskScheduler::TaskGroup instancesUpdates;
+        for (auto const& updater : instancesUpdaters)
+            scheduler->spawn(instancesUpdates, updater);
+        scheduler->wait(instancesUpdates);
+    }while(!sMapMgr.waitContinentUpdateFinishedUntil(start + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))));
 
-    if (continents.valid())
-        continents.wait();
+    scheduler->wait(continents);
 
     asyncMapUpdating = false;
 
@@ -413,6 +420,17 @@ uint32 MapManager::GetNumInstances()
     return ret;
 }
 
+uint32 MapManager::GetNumInstancesAtReducedTickRate()
+{
+    Guard guard(*this);
+
+    uint32 ret = 0;
+    for (const auto& itr : i_maps)
+        if (itr.second->GetTickInterval() > sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))
+            ++ret;
+    return ret;
+}
+
 uint32 MapManager::GetNumPlayersInInstances()
 {
     Guard guard(*this);
@@ -910,12 +928,18 @@ void MapManager::SwitchPlayersInstances()
     }
 }
 
+void MapManager::MarkContinentUpdateStarted()
+{
+    std::unique_lock<std::mutex> lock(m_continentMutex);
+    i_continentUpdateStarted++;
+}
+
 void MapManager::MarkContinentUpdateFinished()
 {
     ASSERT(i_continentUpdateFinished < i_maxContinentThread);
     std::unique_lock<std::mutex> lock(m_continentMutex);
     i_continentUpdateFinished++;
-    if (IsContinentUpdateFinished())
+    if (AreStartedContinentUpdatesFinished())
         m_continentCV.notify_all();
 }
 
@@ -924,6 +948,17 @@ bool MapManager::IsContinentUpdateFinished() const
     return i_continentUpdateFinished == i_maxContinentThread;
 }
 
+bool MapManager::AreStartedContinentUpdatesFinished() const
+{
+    return i_continentUpdateFinished == i_continentUpdateStarted;
+}
+
+bool MapManager::waitStartedContinentUpdatesFinishedUntil(std::chrono::high_resolution_clock::time_point time) const
+{
+    std::unique_lock<std::mutex> lock(m_continentMutex);
+    return m_continentCV.wait_until(lock,time,std::bind(&MapManager::AreStartedContinentUpdatesFinished,this));
+}
+
 bool MapManager::waitContinentUpdateFinishedFor(std::chrono::milliseconds time) const
 {
     std::unique_lock<std::mutex> lock(m_continentMutex);
@@ -27,6 +27,7 @@
 #include "Policies/Singleton.h"
 #include "Map.h"
 #include "GridStates.h"
+#include "TaskScheduler.h"
 #include <condition_variable>
 
 class BattleGround;
@@ -73,7 +74,6 @@ struct MapID
     uint32 nInstanceId;
 };
 
-class ThreadPool;
 struct ScheduledTeleportData;
 
 class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex> >
@@ -171,6 +171,7 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         // statistics
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        uint32 GetNumInstancesAtReducedTickRate();
 
         //get list of all maps
         const MapMapType& Maps() const { return i_maps; }
@@ -185,8 +186,12 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void ExecuteDelayedPlayerTeleports();
         void ExecuteSingleDelayedTeleport(Player *player);
         void CancelDelayedPlayerTeleport(Player *player);
+        void MarkContinentUpdateStarted();
         void MarkContinentUpdateFinished();
         bool IsContinentUpdateFinished() const;
+        // A continent update never waits for an other one still queued: it may be queued behind it
+        bool AreStartedContinentUpdatesFinished() const;
+        bool waitStartedContinentUpdatesFinishedUntil(std::chrono::high_resolution_clock::time_point time) const;
 
         bool waitContinentUpdateFinishedFor(std::chrono::milliseconds time) const;
         bool waitContinentUpdateFinishedUntil(std::chrono::high_resolution_clock::time_point time) const;
@@ -220,10 +225,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         mutable std::mutex      m_continentMutex;
         mutable std::condition_variable      m_continentCV;
+        std::atomic<int> i_continentUpdateStarted{0};
         std::atomic<int> i_continentUpdateFinished{0};
-
-        std::unique_ptr<ThreadPool> m_threads;
-        std::unique_ptr<ThreadPool> m_continentThreads;
         bool asyncMapUpdating = false;
 
         // Instanced continent zones
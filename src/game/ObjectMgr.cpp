@@ -162,8 +162,9 @@ ObjectMgr::~ObjectMgr()
     for (auto& itr : m_CacheTrainerSpellMap)
         itr.second.Clear();
 
-    for (auto& itr : m_playerCacheData)
-        delete itr.second;
+    for (auto& shard : m_playerCacheByGuid)
+        for (auto& itr : shard.players)
+            delete itr.second;
 }
 
 void ObjectMgr::LoadAllIdentifiers()
@@ -650,8 +651,11 @@ void ObjectMgr::LoadSavedVariable()
 // Caching player data
 void ObjectMgr::LoadPlayerCacheData()
 {
-    m_playerCacheData.clear();
-    m_playerNameToGuid.clear();
+    for (auto& shard : m_playerCacheByGuid)
+        shard.players.clear();
+    for (auto& shard : m_playerCacheByName)
+        shard.players.clear();
+    m_playerCacheByAccount.clear();
 
     std::unique_ptr<QueryResult> result(CharacterDatabase.Query(
         //       0       1       2        3         4          5       6        7          8      9             10            11            12             13
@@ -680,10 +684,10 @@ void ObjectMgr::LoadPlayerCacheData()
         std::string name = fields[5].GetCppString();
         if (normalizePlayerName(name))
         {
-            PlayerCacheData* data = InsertPlayerInCache(fields[0].GetUInt32(), fields[1].GetUInt32(), fields[2].GetUInt32(),
+            InsertPlayerInCache(fields[0].GetUInt32(), fields[1].GetUInt32(), fields[2].GetUInt32(),
                 fields[3].GetUInt32(), fields[4].GetUInt32(), name, fields[6].GetUInt32(), fields[7].GetUInt32());
 
-            UpdatePlayerCachedPosition(data, fields[8].GetUInt32(), fields[9].GetFloat(), fields[10].GetFloat(),
+            UpdatePlayerCachedPosition(fields[0].GetUInt32(), fields[8].GetUInt32(), fields[9].GetFloat(), fields[10].GetFloat(),
                 fields[11].GetFloat(), fields[12].GetFloat(), !fields[13].GetCppString().empty());
         }
         ++total_count;
@@ -694,15 +698,17 @@ void ObjectMgr::LoadPlayerCacheData()
     sLog.outString(">> Loaded %u players in cache.", total_count);
 }
 
-PlayerCacheData* ObjectMgr::GetPlayerDataByGUID(uint32 guidLow) const
+PlayerCacheDataPtr ObjectMgr::GetPlayerDataByGUID(uint32 guidLow) const
 {
-    auto itr = m_playerCacheData.find(guidLow);
-    if (itr != m_playerCacheData.end())
+    PlayerCacheGuidShard& shard = GetPlayerCacheShard(guidLow);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.lock);
+    auto itr = shard.players.find(guidLow);
+    if (itr != shard.players.end())
         return itr->second;
     return nullptr;
 }
 
-PlayerCacheData* ObjectMgr::GetPlayerDataByName(std::string const& name) const
+PlayerCacheDataPtr ObjectMgr::GetPlayerDataByName(std::string const& name) const
 {
     if (ObjectGuid guid = GetPlayerGuidByName(name))
         return GetPlayerDataByGUID(guid.GetCounter());
@@ -711,8 +717,10 @@ PlayerCacheData* ObjectMgr::GetPlayerDataByName(std::string const& name) const
 
 ObjectGuid ObjectMgr::GetPlayerGuidByName(std::string const& name) const
 {
-    auto itr = m_playerNameToGuid.find(name);
-    if (itr != m_playerNameToGuid.end())
+    PlayerCacheNameShard& shard = GetPlayerCacheShard(name);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.lock);
+    auto itr = shard.players.find(name);
+    if (itr != shard.players.end())
         return ObjectGuid(HIGHGUID_PLAYER, itr->second);
     return ObjectGuid();
 }
@@ -748,7 +756,7 @@ uint8 ObjectMgr::GetPlayerClassByGUID(ObjectGuid guid) const
 
     uint32 lowguid = guid.GetCounter();
 
-    if (PlayerCacheData* data = GetPlayerDataByGUID(lowguid))
+    if (PlayerCacheDataPtr data = GetPlayerDataByGUID(lowguid))
     {
         return data->uiClass;
     }
@@ -783,7 +791,7 @@ uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(std::string const& name) const
     return 0;
 }
 
-PlayerCacheData* ObjectMgr::InsertPlayerInCache(Player* pPlayer)
+PlayerCacheDataPtr ObjectMgr::InsertPlayerInCache(Player* pPlayer)
 {
     auto pSession = pPlayer->GetSession();
     if (!pSession)
@@ -795,58 +803,94 @@ PlayerCacheData* ObjectMgr::InsertPlayerInCache(Player* pPlayer)
 
 void ObjectMgr::UpdatePlayerCachedPosition(Player* pPlayer)
 {
-    auto iter = m_playerCacheData.find(pPlayer->GetGUIDLow());
-    PlayerCacheData* data = nullptr;
-    if (iter == m_playerCacheData.end())
-        data = InsertPlayerInCache(pPlayer);
-    else
-        data = iter->second;
-
-    if (!data)
+    if (!GetPlayerDataByGUID(pPlayer->GetGUIDLow()) && !InsertPlayerInCache(pPlayer))
         return;
 
-    UpdatePlayerCachedPosition(data, pPlayer->GetMapId(), pPlayer->GetPositionX(), pPlayer->GetPositionY(),
+    UpdatePlayerCachedPosition(pPlayer->GetGUIDLow(), pPlayer->GetMapId(), pPlayer->GetPositionX(), pPlayer->GetPositionY(),
         pPlayer->GetPositionZ(), pPlayer->GetOrientation(), pPlayer->IsTaxiFlying());
 }
 
 void ObjectMgr::UpdatePlayerCachedPosition(uint32 lowGuid, uint32 mapId, float posX, float posY, float posZ, float o, bool inFlight)
 {
-    auto iter = m_playerCacheData.find(lowGuid);
-    if (iter == m_playerCacheData.end())
+    PlayerCacheGuidShard& shard = GetPlayerCacheShard(lowGuid);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+    auto itr = shard.players.find(lowGuid);
+    if (itr == shard.players.end())
         return;
 
-    UpdatePlayerCachedPosition(iter->second, mapId, posX, posY, posZ, o, inFlight);
-}
-
-void ObjectMgr::UpdatePlayerCachedPosition(PlayerCacheData* data, uint32 mapId, float posX, float posY, float posZ, float o, bool inFlight)
-{
+    std::shared_ptr<PlayerCacheData> data = std::make_shared<PlayerCacheData>(*itr->second);
     data->uiMapId = mapId;
     data->fPosX = posX;
     data->fPosY = posY;
     data->fPosZ = posZ;
     data->fOrientation = o;
     data->bInFlight = inFlight;
+    itr->second = std::move(data);
 }
 
-void ObjectMgr::UpdatePlayerCache(Player* pPlayer)
+void ObjectMgr::UpdatePlayerCachedLevelAndZone(uint32 lowGuid, uint32 level, uint32 zoneId)
 {
-    auto iter = m_playerCacheData.find(pPlayer->GetGUIDLow());
-    PlayerCacheData* data = nullptr;
-    if (iter == m_playerCacheData.end())
-        data = InsertPlayerInCache(pPlayer);
-    else
-        data = iter->second;
+    PlayerCacheGuidShard& shard = GetPlayerCacheShard(lowGuid);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+    auto itr = shard.players.find(lowGuid);
+    if (itr == shard.players.end())
+        return;
+
+    std::shared_ptr<PlayerCacheData> data = std::make_shared<PlayerCacheData>(*itr->second);
+    data->uiLevel = level;
+    data->uiZoneId = zoneId;
+    itr->second = std::move(data);
+}
 
-    if (!data)
+void ObjectMgr::UpdatePlayerCache(Player* pPlayer)
+{
+    if (!GetPlayerDataByGUID(pPlayer->GetGUIDLow()) && !InsertPlayerInCache(pPlayer))
         return;
+
     if (pPlayer->GetSession())
-        UpdatePlayerCache(data, pPlayer->GetRace(), pPlayer->GetClass(), pPlayer->GetGender(), pPlayer->GetSession()->GetAccountId(), pPlayer->GetName(), pPlayer->GetLevel(), pPlayer->GetCachedZoneId());
+        UpdatePlayerCache(pPlayer->GetGUIDLow(), pPlayer->GetRace(), pPlayer->GetClass(), pPlayer->GetGender(), pPlayer->GetSession()->GetAccountId(), pPlayer->GetName(), pPlayer->GetLevel(), pPlayer->GetCachedZoneId());
 
-    UpdatePlayerCachedPosition(data, pPlayer->GetMapId(), pPlayer->GetPositionX(), pPlayer->GetPositionY(), pPlayer->GetPositionZ(), pPlayer->GetOrientation(), pPlayer->IsTaxiFlying());
+    UpdatePlayerCachedPosition(pPlayer->GetGUIDLow(), pPlayer->GetMapId(), pPlayer->GetPositionX(), pPlayer->GetPositionY(), pPlayer->GetPositionZ(), pPlayer->GetOrientation(), pPlayer->IsTaxiFlying());
 }
 
-void ObjectMgr::UpdatePlayerCache(PlayerCacheData* data, uint32 race, uint32 _class, uint32 gender, uint32 accountId, std::string const& name, uint32 level, uint32 zoneId)
+void ObjectMgr::UpdatePlayerCache(uint32 lowGuid, uint32 race, uint32 _class, uint32 gender, uint32 accountId, std::string const& name, uint32 level, uint32 zoneId)
 {
+    std::string oldName;
+    uint32 oldAccountId;
+    {
+        PlayerCacheGuidShard& shard = GetPlayerCacheShard(lowGuid);
+        std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+        auto itr = shard.players.find(lowGuid);
+        if (itr == shard.players.end())
+            return;
+
+        std::shared_ptr<PlayerCacheData> data = std::make_shared<PlayerCacheData>(*itr->second);
+        oldName = data->sName;
+        oldAccountId = data->uiAccount;
+        data->uiAccount = accountId;
+        data->uiRace = race;
+        data->uiClass = _class;
+        data->uiGender = gender;
+        data->uiLevel = level;
+        data->sName = name;
+        data->uiZoneId = zoneId;
+        itr->second = std::move(data);
+    }
+
+    // keep the indexes in sync
+    if (oldAccountId != accountId)
+        MovePlayerCacheAccount(lowGuid, oldAccountId, accountId);
+    if (oldName != name)
+        MovePlayerCacheName(lowGuid, oldName, name);
+}
+
+PlayerCacheDataPtr ObjectMgr::InsertPlayerInCache(uint32 lowGuid, uint32 race, uint32 _class, uint32 gender, uint32 accountId, std::string const& name, uint32 level, uint32 zoneId)
+{
+    // a new character can reuse the guid of a deleted one
+    DeletePlayerFromCache(lowGuid);
+
+    std::shared_ptr<PlayerCacheData> data = std::make_shared<PlayerCacheData>();
+    data->uiGuid = lowGuid;
     data->uiAccount = accountId;
     data->uiRace = race;
     data->uiClass = _class;
@@ -854,50 +898,103 @@ void ObjectMgr::UpdatePlayerCache(PlayerCacheData* data, uint32 race, uint32 _cl
     data->uiLevel = level;
     data->sName = name;
     data->uiZoneId = zoneId;
-}
-
-PlayerCacheData* ObjectMgr::InsertPlayerInCache(uint32 lowGuid, uint32 race, uint32 _class, uint32 gender, uint32 accountId, std::string const& name, uint32 level, uint32 zoneId)
-{
-    auto data = new PlayerCacheData;
-    data->uiGuid = lowGuid;
-    UpdatePlayerCache(data, race, _class, gender, accountId, name, level, zoneId);
 
-    m_playerCacheData[lowGuid] = data;
-    m_playerNameToGuid[name] = lowGuid;
+    {
+        PlayerCacheGuidShard& shard = GetPlayerCacheShard(lowGuid);
+        std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+        shard.players[lowGuid] = data;
+    }
+    MovePlayerCacheName(lowGuid, std::string(), name);
+    MovePlayerCacheAccount(lowGuid, 0, accountId);
 
     return data;
 }
 
 void ObjectMgr::DeletePlayerFromCache(uint32 lowGuid)
 {
-    auto itr = m_playerCacheData.find(lowGuid);
-    if (itr != m_playerCacheData.end())
+    PlayerCacheDataPtr data;
     {
-        auto itr2 = m_playerNameToGuid.find(itr->second->sName);
-        if (itr2 != m_playerNameToGuid.end())
-            m_playerNameToGuid.erase(itr2);
-        m_playerCacheData.erase(itr);
+        PlayerCacheGuidShard& shard = GetPlayerCacheShard(lowGuid);
+        std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+        auto itr = shard.players.find(lowGuid);
+        if (itr == shard.players.end())
+            return;
+        data = std::move(itr->second);
+        shard.players.erase(itr);
     }
+    MovePlayerCacheName(lowGuid, data->sName, std::string());
+    MovePlayerCacheAccount(lowGuid, data->uiAccount, 0);
 }
 
 void ObjectMgr::ChangePlayerNameInCache(uint32 guidLow, std::string const& oldName, std::string const& newName)
 {
-    auto itr = m_playerCacheData.find(guidLow);
-    if (itr != m_playerCacheData.end())
     {
-        m_playerNameToGuid.erase(oldName);
-        m_playerNameToGuid[newName] = guidLow;
-        itr->second->sName = newName;
+        PlayerCacheGuidShard& shard = GetPlayerCacheShard(guidLow);
+        std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+        auto itr = shard.players.find(guidLow);
+        if (itr == shard.players.end())
+            return;
+
+        std::shared_ptr<PlayerCacheData> data = std::make_shared<PlayerCacheData>(*itr->second);
+        data->sName = newName;
+        itr->second = std::move(data);
+    }
+    MovePlayerCacheName(guidLow, oldName, newName);
+}
+
+// empty name: not indexed
+void ObjectMgr::MovePlayerCacheName(uint32 lowGuid, std::string const& oldName, std::string const& newName)
+{
+    if (!oldName.empty())
+    {
+        PlayerCacheNameShard& shard = GetPlayerCacheShard(oldName);
+        std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+        auto itr = shard.players.find(oldName);
+        if (itr != shard.players.end() && itr->second == lowGuid)
+            shard.players.erase(itr);
+    }
+    if (!newName.empty())
+    {
+        PlayerCacheNameShard& shard = GetPlayerCacheShard(newName);
+        std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+        shard.players[newName] = lowGuid;
     }
 }
 
-void ObjectMgr::GetPlayerDataForAccount(uint32 accountId, std::list<PlayerCacheData*>& data) const
+// account 0: not indexed
+void ObjectMgr::MovePlayerCacheAccount(uint32 lowGuid, uint32 oldAccountId, uint32 newAccountId)
 {
-    for (const auto& iter : m_playerCacheData)
+    std::unique_lock<std::shared_timed_mutex> lock(m_playerCacheByAccountLock);
+    if (oldAccountId)
     {
-        if (iter.second->uiAccount == accountId)
-            data.push_back(iter.second);
+        auto itr = m_playerCacheByAccount.find(oldAccountId);
+        if (itr != m_playerCacheByAccount.end())
+        {
+            itr->second.erase(std::remove(itr->second.begin(), itr->second.end(), lowGuid), itr->second.end());
+            if (itr->second.empty())
+                m_playerCacheByAccount.erase(itr);
+        }
     }
+    if (newAccountId)
+        m_playerCacheByAccount[newAccountId].push_back(lowGuid);
+}
+
+void ObjectMgr::GetPlayerDataForAccount(uint32 accountId, std::list<PlayerCacheDataPtr>& data) const
+{
+    std::vector<uint32> guids;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_playerCacheByAccountLock);
+        auto itr = m_playerCacheByAccount.find(accountId);
+        if (itr == m_playerCacheByAccount.end())
+            return;
+        guids = itr->second;
+    }
+
+    // oldest character first
+    std::sort(guids.begin(), guids.end());
+    for (uint32 guid : guids)
+        if (PlayerCacheDataPtr player = GetPlayerDataByGUID(guid))
+            data.push_back(std::move(player));
 }
 
 Group* ObjectMgr::GetGroupById(uint32 id) const
@@ -1457,7 +1554,7 @@ void ObjectMgr::CheckCreatureTemplates()
     }
 }
 
-void ObjectMgr::LoadCreatureAddons(SQLStorage& creatureaddons, char const* entryName, char const* comment)
+void ObjectMgr::LoadCreatureAddons(SQLSortedStorage& creatureaddons, char const* entryName, char const* comment)
 {
     creatureaddons.LoadProgressive(sWorld.GetWowPatch());
 
@@ -1465,11 +1562,10 @@ void ObjectMgr::LoadCreatureAddons(SQLStorage& creatureaddons, char const* entry
     sLog.outString();
 
     // check data correctness and convert 'auras'
-    for (uint32 i = 1; i < creatureaddons.GetMaxEntry(); ++i)
+    // (the guids are sparse, walk the records rather than the id range)
+    for (auto itr = creatureaddons.begin<CreatureDataAddon>(); itr < creatureaddons.end<CreatureDataAddon>(); ++itr)
     {
-        CreatureDataAddon const* addon = creatureaddons.LookupEntry<CreatureDataAddon>(i);
-        if (!addon)
-            continue;
+        CreatureDataAddon const* addon = *itr;
 
         if (addon->display_id > 0)
         {
@@ -1525,11 +1621,10 @@ void ObjectMgr::LoadCreatureAddons()
     LoadCreatureAddons(sCreatureDataAddonStorage, "GUID", "creature addons");
 
     // check entry ids
-    for (uint32 i = 1; i < sCreatureDataAddonStorage.GetMaxEntry(); ++i)
-        if (CreatureDataAddon const* addon = sCreatureDataAddonStorage.LookupEntry<CreatureDataAddon>(i))
-            if (m_CreatureDataMap.find(addon->guid) == m_CreatureDataMap.end())
-                if (!sObjectMgr.IsExistingCreatureGuid(addon->guid))
-                    sLog.outErrorDb("Creature (GUID: %u) does not exist but has a record in `creature_addon`", addon->guid);
+    for (auto itr = sCreatureDataAddonStorage.begin<CreatureDataAddon>(); itr < sCreatureDataAddonStorage.end<CreatureDataAddon>(); ++itr)
+        if (m_CreatureDataMap.find(itr->guid) == m_CreatureDataMap.end())
+            if (!sObjectMgr.IsExistingCreatureGuid(itr->guid))
+                sLog.outErrorDb("Creature (GUID: %u) does not exist but has a record in `creature_addon`", itr->guid);
 }
 
 EquipmentInfo const* ObjectMgr::GetEquipmentInfo(uint32 entry)
@@ -2124,8 +2219,9 @@ CreatureClassLevelStats const* ObjectMgr::GetCreatureClassLevelStats(uint32 unit
 void ObjectMgr::LoadCreatures(bool reload)
 {
     uint32 count = 0;
+    uint32 const startTime = WorldTimer::getMSTime();
     //                                                                          0                  1                2                 3                 4      5
-    std::unique_ptr<QueryResult> result(WorldDatabase.Query("SELECT `creature`.`guid`, `creature`.`id`, `creature`.`id2`, `creature`.`id3`, `creature`.`id4`, `map`,"
+    std::unique_ptr<QueryResult> result(WorldDatabase.QueryTyped("SELECT `creature`.`guid`, `creature`.`id`, `creature`.`id2`, `creature`.`id3`, `creature`.`id4`, `map`,"
     //                      6             7             8             9              10                  11                  12
                           "`position_x`, `position_y`, `position_z`, `orientation`, `spawntimesecsmin`, `spawntimesecsmax`, `wander_distance`, "
     //                      13                14              15               16
@@ -2307,7 +2403,7 @@ void ObjectMgr::LoadCreatures(bool reload)
     while (result->NextRow());
 
     sLog.outString();
-    sLog.outString(">> Loaded %lu creatures", (unsigned long)m_CreatureDataMap.size());
+    sLog.outString(">> Loaded %lu creatures in %u ms", (unsigned long)m_CreatureDataMap.size(), WorldTimer::getMSTimeDiffToNow(startTime));
 }
 
 void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
@@ -2333,9 +2429,10 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
 void ObjectMgr::LoadGameobjects(bool reload)
 {
     uint32 count = 0;
+    uint32 const startTime = WorldTimer::getMSTime();
 
     //                                                                            0                    1     2      3             4             5             6
-    std::unique_ptr<QueryResult> result(WorldDatabase.Query("SELECT `gameobject`.`guid`, `gameobject`.`id`, `map`, `position_x`, `position_y`, `position_z`, `orientation`,"
+    std::unique_ptr<QueryResult> result(WorldDatabase.QueryTyped("SELECT `gameobject`.`guid`, `gameobject`.`id`, `map`, `position_x`, `position_y`, `position_z`, `orientation`,"
     //                      7            8            9            10           11                12              13       14      15
                           "`rotation0`, `rotation1`, `rotation2`, `rotation3`, `spawntimesecsmin`, `spawntimesecsmax`, `animprogress`, `state`, `event`, "
     //                                        16                                       17            18             19                             20                        21
@@ -2484,7 +2581,7 @@ void ObjectMgr::LoadGameobjects(bool reload)
     while (result->NextRow());
 
     sLog.outString();
-    sLog.outString(">> Loaded %lu gameobjects", (unsigned long)m_GameObjectDataMap.size());
+    sLog.outString(">> Loaded %lu gameobjects in %u ms", (unsigned long)m_GameObjectDataMap.size(), WorldTimer::getMSTimeDiffToNow(startTime));
 }
 
 void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
@@ -7341,7 +7438,7 @@ void ObjectMgr::LoadGameObjectLocales()
     sLog.outString(">> Loaded %lu gameobject locale strings", (unsigned long)m_GameObjectLocaleMap.size());
 }
 
-struct SQLGameObjectLoader : public SQLStorageLoaderBase<SQLGameObjectLoader, SQLHashStorage>
+struct SQLGameObjectLoader : public SQLStorageLoaderBase<SQLGameObjectLoader, SQLSortedStorage>
 {
     template<class D>
     void convert_from_str(uint32 /*field_pos*/, char const* src, D& dst)
@@ -38,6 +38,9 @@
 #include <string>
 #include <map>
 #include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 
 extern SQLStorage sCreatureDataLinkGroupStorage;
 
@@ -429,7 +432,9 @@ struct PlayerCacheData
     float fOrientation;
     bool bInFlight;
 };
-typedef std::map<uint32 /*guid*/, PlayerCacheData*> PlayerCacheDataMap;
+
+// Snapshot of a cache entry: updates replace the entry, they never modify it
+typedef std::shared_ptr<PlayerCacheData const> PlayerCacheDataPtr;
 
 struct FactionChangeMountData
 {
@@ -1242,21 +1247,46 @@ class ObjectMgr
 
         // Caching Player Data
         void LoadPlayerCacheData();
-        PlayerCacheData* GetPlayerDataByGUID(uint32 lowGuid) const;
-        PlayerCacheData* GetPlayerDataByName(std::string const& name) const;
-        void GetPlayerDataForAccount(uint32 accountId, std::list<PlayerCacheData*>& data) const;
-        PlayerCacheData* InsertPlayerInCache(Player* pPlayer);
-        PlayerCacheData* InsertPlayerInCache(uint32 lowGuid, uint32 race, uint32 _class, uint32 uiGender, uint32 account, std::string const& name, uint32 level, uint32 zoneId);
+        PlayerCacheDataPtr GetPlayerDataByGUID(uint32 lowGuid) const;
+        PlayerCacheDataPtr GetPlayerDataByName(std::string const& name) const;
+        void GetPlayerDataForAccount(uint32 accountId, std::list<PlayerCacheDataPtr>& data) const;
+        PlayerCacheDataPtr InsertPlayerInCache(Player* pPlayer);
+        PlayerCacheDataPtr InsertPlayerInCache(uint32 lowGuid, uint32 race, uint32 _class, uint32 uiGender, uint32 account, std::string const& name, uint32 level, uint32 zoneId);
         void DeletePlayerFromCache(uint32 lowGuid);
         void ChangePlayerNameInCache(uint32 lowGuid, std::string const& oldName, std::string const& newName);
         void UpdatePlayerCachedPosition(Player* pPlayer);
         void UpdatePlayerCachedPosition(uint32 lowGuid, uint32 mapId, float posX, float posY, float posZ, float o, bool inFlight);
-        void UpdatePlayerCachedPosition(PlayerCacheData* data, uint32 mapId, float posX, float posY, float posZ, float o, bool inFlight);
+        void UpdatePlayerCachedLevelAndZone(uint32 lowGuid, uint32 level, uint32 zoneId);
         void UpdatePlayerCache(Player* pPlayer);
-        void UpdatePlayerCache(PlayerCacheData* data, uint32 race, uint32 _class, uint32 gender, uint32 accountId, std::string const& name, uint32 level, uint32 zoneId);
+        void UpdatePlayerCache(uint32 lowGuid, uint32 race, uint32 _class, uint32 gender, uint32 accountId, std::string const& name, uint32 level, uint32 zoneId);
 
-        PlayerCacheDataMap m_playerCacheData;
-        std::map<std::string, uint32> m_playerNameToGuid;
+    private:
+        void MovePlayerCacheName(uint32 lowGuid, std::string const& oldName, std::string const& newName);
+        void MovePlayerCacheAccount(uint32 lowGuid, uint32 oldAccountId, uint32 newAccountId);
+
+        // Every character has its entry (name checks rely on it), looked up from any
+        // thread: the indexes are split in shards, each behind its own lock. Entries
+        // are immutable: an update stores a modified copy under the lock of the guid
+        // shard, readers keep their snapshot as long as they need it.
+        static uint32 const PLAYER_CACHE_SHARDS = 16;
+        struct PlayerCacheGuidShard
+        {
+            std::shared_timed_mutex lock;
+            std::unordered_map<uint32 /*guid*/, PlayerCacheDataPtr> players;
+        };
+        struct PlayerCacheNameShard
+        {
+            std::shared_timed_mutex lock;
+            std::unordered_map<std::string, uint32 /*guid*/> players;
+        };
+        PlayerCacheGuidShard& GetPlayerCacheShard(uint32 lowGuid) const { return m_playerCacheByGuid[lowGuid % PLAYER_CACHE_SHARDS]; }
+        PlayerCacheNameShard& GetPlayerCacheShard(std::string const& name) const { return m_playerCacheByName[std::hash<std::string>()(name) % PLAYER_CACHE_SHARDS]; }
+
+        mutable PlayerCacheGuidShard m_playerCacheByGuid[PLAYER_CACHE_SHARDS];
+        mutable PlayerCacheNameShard m_playerCacheByName[PLAYER_CACHE_SHARDS];
+        mutable std::shared_timed_mutex m_playerCacheByAccountLock;
+        std::unordered_map<uint32 /*account*/, std::vector<uint32> /*guids*/> m_playerCacheByAccount;
+    public:
 
         uint32 AddCreData(uint32 entry, uint32 team, uint32 map, float, float, float, float, uint32 spawnDelay);
         uint32 AddGOData(uint32 entry, uint32 map, float, float, float, float, uint32 spawnTimeDelay, float, float, float, float);
@@ -1445,7 +1475,7 @@ class ObjectMgr
         uint32 m_OldMailCounter;
 
     private:
-        void LoadCreatureAddons(SQLStorage& creatureaddons, char const* entryName, char const* comment);
+        void LoadCreatureAddons(SQLSortedStorage& creatureaddons, char const* entryName, char const* comment);
         void LoadQuestRelationsHelper(QuestRelationsMap& map, char const* table);
         void LoadVendors(char const* tableName, bool isTemplates);
         void LoadTrainers(char const* tableName, bool isTemplates);
@@ -406,6 +406,96 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updat
     data.AddUpdateBlock(buf);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, ValuesUpdateCache& cache) const
+{
+    uint16 const* flags = nullptr;
+    uint32 key = GetUpdateFieldFlagsForTarget(target, flags);
+    ASSERT(flags);
+    if (target->IsGameMaster())
+        key |= UF_CACHE_KEY_GAMEMASTER;
+
+    for (auto const& entry : cache.entries)
+    {
+        if (entry.key != key)
+            continue;
+
+        if (!entry.shareable)
+        {
+            BuildValuesUpdateBlockForPlayer(data, target);
+            return;
+        }
+
+        if (entry.block.size())
+        {
+            data.AddUpdateBlock(entry.block);
+            ++cache.sharedBlocks;
+            cache.sharedBytes += entry.block.size();
+        }
+        return;
+    }
+
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+    {
+        if ((m_uint32Values_mirror[index] != m_uint32Values[index]) && (flags[index] & key))
+            updateMask.SetBit(index);
+    }
+
+    if (!updateMask.HasData())
+    {
+        cache.entries.push_back({ key, true, ByteBuffer(0) });
+        return;
+    }
+
+    // Private fields are only seen by the object itself
+    if ((key & UF_FLAG_PRIVATE) || !IsValuesUpdateShareable(updateMask))
+    {
+        cache.entries.push_back({ key, false, ByteBuffer(0) });
+        BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+        return;
+    }
+
+    ByteBuffer buf(500);
+    buf << uint8(UPDATETYPE_VALUES);
+#if SUPPORTED_CLIENT_BUILD > CLIENT_BUILD_1_8_4
+    buf << GetPackGUID();
+#else
+    buf << GetGUID();
+#endif
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    data.AddUpdateBlock(buf);
+    ++cache.builtBlocks;
+    cache.entries.push_back({ key, true, std::move(buf) });
+}
+
+// Fields whose value sent depends on the observer, see BuildValuesUpdate
+bool Object::IsValuesUpdateShareable(UpdateMask const& updateMask) const
+{
+    switch (GetTypeId())
+    {
+        case TYPEID_GAMEOBJECT:
+            return false;
+        case TYPEID_CORPSE:
+            return !updateMask.GetBit(CORPSE_FIELD_DYNAMIC_FLAGS);
+        case TYPEID_PLAYER:
+            if (updateMask.GetBit(PLAYER_FLAGS))
+                return false;
+            // no break
+        case TYPEID_UNIT:
+            if (updateMask.GetBit(UNIT_NPC_FLAGS) ||
+                updateMask.GetBit(UNIT_DYNAMIC_FLAGS) ||
+                updateMask.GetBit(UNIT_FIELD_FACTIONTEMPLATE))
+                return false;
+            if (!sWorld.getConfig(CONFIG_BOOL_OBJECT_HEALTH_VALUE_SHOW) &&
+                (updateMask.GetBit(UNIT_FIELD_HEALTH) || updateMask.GetBit(UNIT_FIELD_MAXHEALTH)))
+                return false;
+            return true;
+        default:
+            return true;
+    }
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData& data) const
 {
     data.AddOutOfRangeGUID(GetObjectGuid());
@@ -1278,7 +1368,7 @@ bool Object::PrintIndexError(uint32 index, bool set) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1289,7 +1379,10 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
+    if (cache)
+        BuildValuesUpdateBlockForPlayer(iter->second, iter->first, *cache);
+    else
+        BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
 }
 
 void Object::AddToClientUpdateList()
@@ -2747,6 +2840,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType &i_updateDatas;
     WorldObject &i_object;
+    ValuesUpdateCache i_cache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2761,7 +2855,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter.getSource()->GetOwner();
             if (owner != &i_object && owner->IsInVisibleList_Unsafe(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_cache);
         }
     }
 
@@ -2773,6 +2867,7 @@ void WorldObject::BuildUpdateData(UpdateDataMapType & update_players)
     WorldObjectChangeAccumulator notifier(*this, update_players);
     // Update with modifier for long range players
     Cell::VisitWorldObjects(this, notifier, std::max(GetMap()->GetVisibilityDistance(), GetVisibilityModifier()));
+    GetMap()->AddValuesUpdateStats(notifier.i_cache);
 
     ClearUpdateMask(false);
 }
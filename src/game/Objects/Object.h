@@ -34,6 +34,7 @@
 #include "Timer.h"
 #include "Camera.h"
 #include "Cell.h"
+#include "DirtyList.h"
 
 #include <string>
 
@@ -57,6 +58,29 @@ struct FactionTemplateEntry;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// Values update blocks of an object built during one BuildUpdateData call.
+// Observers seeing the same update fields (same visibility flags, GM or not)
+// get the same block, unless a field value depends on the observer itself.
+// The key of a block is the UpdateFieldFlags of the observer, plus these flags.
+enum ValuesUpdateCacheKeyFlags : uint32
+{
+    UF_CACHE_KEY_GAMEMASTER = 0x10000,                      // above the 16 UpdateFieldFlags bits: GMs are sent other values for some fields
+};
+
+struct ValuesUpdateCache
+{
+    struct Entry
+    {
+        uint32 key;
+        bool shareable;
+        ByteBuffer block;
+    };
+    std::vector<Entry> entries;
+    uint32 builtBlocks = 0;
+    uint32 sharedBlocks = 0;
+    uint32 sharedBytes = 0;
+};
+
 //use this class to measure time between world update ticks
 //essential for units updating their spells after cells become active
 class WorldUpdateCounter
@@ -298,12 +322,14 @@ class Object
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const;
         void BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags, bool includingEmpty = false) const;
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updateMask, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, ValuesUpdateCache& cache) const;
+        bool IsValuesUpdateShareable(UpdateMask const& updateMask) const;
         void BuildOutOfRangeUpdateBlock(UpdateData& data) const;
         void BuildMovementUpdateBlock(UpdateData& data, uint8 flags = 0) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache = nullptr);
 
         void SendOutOfRangeUpdateToPlayer(Player* player);
 
@@ -532,6 +558,9 @@ class Object
 
         virtual bool HasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool HasInvolvedQuest(uint32 /* quest_id */) const { return false; }
+
+        // Membership in Map::i_objectsToClientUpdate
+        DirtyListSlot m_clientUpdateSlot;
     protected:
 
         Object ();
@@ -924,6 +953,10 @@ class WorldObject : public Object
         uint32 GetCreatureSummonLimit() const;
         void SetCreatureSummonLimit(uint32 limit);
 
+        // Membership of units in Map::i_unitsRelocated and Map::unitsMvtUpdate
+        DirtyListSlot m_relocatedSlot;
+        DirtyListSlot m_movementUpdateSlot;
+
     protected:
         explicit WorldObject();
 
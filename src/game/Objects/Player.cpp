@@ -80,6 +80,8 @@
 #include "world/scourge_invasion.h"
 #include "world/world_event_wareffort.h"
 
+#include <atomic>
+
 #define ZONE_UPDATE_INTERVAL (1*IN_MILLISECONDS)
 
 #define PLAYER_SKILL_INDEX(x)       (PLAYER_SKILL_INFO_1_1 + ((x)*3))
@@ -594,6 +596,8 @@ Player::Player(WorldSession* session) : Unit(),
     // randomize first save time in range [CONFIG_UINT32_INTERVAL_SAVE] around [CONFIG_UINT32_INTERVAL_SAVE]
     // this must help in case next save after mass player load after server startup
     m_nextSave = urand(m_nextSave / 2, m_nextSave * 3 / 2);
+    m_savedAurasValid = false;
+    m_savedCooldownsValid = false;
 
     ClearResurrectRequestData();
 
@@ -4295,14 +4299,11 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
 
 void Player::_SaveSpellCooldowns()
 {
+    static SqlStatementID deleteSpellCooldowns;
     static SqlStatementID deleteSpellCooldown;
-
-    // delete all old cooldown
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
-
     static SqlStatementID insertSpellCooldown;
 
+    std::map<uint32, SavedCooldown> cooldowns;
     for (auto& cdItr : m_cooldownMap)
     {
         auto& cdData = cdItr.second;
@@ -4312,19 +4313,51 @@ void Player::_SaveSpellCooldowns()
             TimePoint cTime = TimePoint::min();
             cdData->GetSpellCDExpireTime(sTime);
             cdData->GetCatCDExpireTime(cTime);
-            uint64 spellExpireTime = uint64(Clock::to_time_t(sTime));
-            uint64 catExpireTime = uint64(Clock::to_time_t(cTime));
 
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO `character_spell_cooldown` (`guid`, `spell`, `spell_expire_time`, `category`, `category_expire_time`, `item_id`) VALUES( ?, ?, ?, ?, ?, ?)");
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt32(cdData->GetSpellId());
-            stmt.addUInt64(spellExpireTime);
-            stmt.addUInt32(cdData->GetCategory());
-            stmt.addUInt64(catExpireTime);
-            stmt.addUInt32(cdData->GetItemId());
-            stmt.Execute();
+            SavedCooldown& cooldown = cooldowns[cdData->GetSpellId()];
+            cooldown.spellExpireTime = uint64(Clock::to_time_t(sTime));
+            cooldown.category = cdData->GetCategory();
+            cooldown.categoryExpireTime = uint64(Clock::to_time_t(cTime));
+            cooldown.itemId = cdData->GetItemId();
         }
     }
+
+    if (!m_savedCooldownsValid)
+    {
+        // delete all old cooldown
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldowns, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
+        stmt.PExecute(GetGUIDLow());
+        m_savedCooldowns.clear();
+        m_savedCooldownsValid = true;
+    }
+    else
+    {
+        // cooldowns expired or removed since the last save
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ? AND `spell` = ?");
+        for (auto const& itr : m_savedCooldowns)
+            if (cooldowns.find(itr.first) == cooldowns.end())
+                stmt.PExecute(GetGUIDLow(), itr.first);
+    }
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "REPLACE INTO `character_spell_cooldown` (`guid`, `spell`, `spell_expire_time`, `category`, `category_expire_time`, `item_id`) VALUES( ?, ?, ?, ?, ?, ?)");
+    for (auto const& itr : cooldowns)
+    {
+        SavedCooldown const& cooldown = itr.second;
+        auto saved = m_savedCooldowns.find(itr.first);
+        if (saved != m_savedCooldowns.end() && saved->second.spellExpireTime == cooldown.spellExpireTime &&
+            saved->second.category == cooldown.category && saved->second.categoryExpireTime == cooldown.categoryExpireTime &&
+            saved->second.itemId == cooldown.itemId)
+            continue;
+
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(itr.first);
+        stmt.addUInt64(cooldown.spellExpireTime);
+        stmt.addUInt32(cooldown.category);
+        stmt.addUInt64(cooldown.categoryExpireTime);
+        stmt.addUInt32(cooldown.itemId);
+        stmt.Execute();
+    }
+    m_savedCooldowns.swap(cooldowns);
 }
 
 void Player::UpdateResetTalentsMultiplier() const
@@ -4631,7 +4664,7 @@ void Player::DeleteFromDB(ObjectGuid playerGuid, uint32 accountId, bool updateRe
         charDelete_method = 0;
     else
     {
-        PlayerCacheData const* data = sObjectMgr.GetPlayerDataByGUID(playerGuid);
+        PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByGUID(playerGuid);
         if (data && data->uiLevel < charDelete_minLvl)
             charDelete_method = 0;
     }
@@ -6810,7 +6843,7 @@ uint32 Player::GetZoneIdFromDB(ObjectGuid guid)
 {
     uint32 lowguid = guid.GetCounter();
     uint32 zone = 0;
-    if (PlayerCacheData* data = sObjectMgr.GetPlayerDataByGUID(guid))
+    if (PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByGUID(guid))
     {
         if (data->uiZoneId)
             zone = data->uiZoneId;
@@ -6852,7 +6885,7 @@ uint32 Player::GetLevelFromDB(ObjectGuid guid)
 {
     uint32 lowguid = guid.GetCounter();
 
-    if (PlayerCacheData* data = sObjectMgr.GetPlayerDataByGUID(lowguid))
+    if (PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByGUID(lowguid))
     {
         return data->uiLevel;
     }
@@ -14770,7 +14803,7 @@ void Player::_LoadBGData(QueryResult* result)
 
 bool Player::LoadPositionFromDB(ObjectGuid guid, uint32& mapid, float& x, float& y, float& z, float& o, bool& in_flight)
 {
-    if (PlayerCacheData* data = sObjectMgr.GetPlayerDataByGUID(guid.GetCounter()))
+    if (PlayerCacheDataPtr data = sObjectMgr.GetPlayerDataByGUID(guid.GetCounter()))
     {
         x = data->fPosX;
         y = data->fPosY;
@@ -16556,13 +16589,18 @@ bool Player::SaveNewPlayer(WorldSession* session, uint32 guidlow, std::string co
     MasterPlayer masterPlayer(session);
     masterPlayer.Create(ObjectGuid(HIGHGUID_PLAYER, guidlow), raceId, classId);
     masterPlayer.SaveToDB();
-    PlayerCacheData* cacheData = sObjectMgr.InsertPlayerInCache(guidlow, raceId, classId, gender, session->GetAccountId(), name, startingLevel, zoneId);
-    sObjectMgr.UpdatePlayerCachedPosition(cacheData, info->mapId, info->positionX, info->positionY, info->positionZ, info->orientation, false);
+    sObjectMgr.InsertPlayerInCache(guidlow, raceId, classId, gender, session->GetAccountId(), name, startingLevel, zoneId);
+    sObjectMgr.UpdatePlayerCachedPosition(guidlow, info->mapId, info->positionX, info->positionY, info->positionZ, info->orientation, false);
     sWorld.LogCharacter(session, guidlow, name, "Create");
 
     return true;
 }
 
+// Statements written by Player::SaveToDB, called by the map threads
+static std::atomic<uint64> s_saveCount(0);
+static std::atomic<uint64> s_saveStatements(0);
+static std::atomic<uint32> s_saveMaxStatements(0);
+
 void Player::SaveToDB(bool online, bool force)
 {
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
@@ -16752,8 +16790,14 @@ void Player::SaveToDB(bool online, bool force)
     sObjectMgr.SetPlayerWorldMask(GetGUIDLow(), GetWorldMask());
     GetSession()->SaveTutorialsData();                      // changed only while character in game
 
+    uint32 const statements = uint32(CharacterDatabase.GetTransactionSize());
     CharacterDatabase.CommitTransaction();
 
+    ++s_saveCount;
+    s_saveStatements += statements;
+    uint32 maxStatements = s_saveMaxStatements;
+    while (statements > maxStatements && !s_saveMaxStatements.compare_exchange_weak(maxStatements, statements)) {}
+
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->IsLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
@@ -16762,11 +16806,16 @@ void Player::SaveToDB(bool online, bool force)
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
-    if (PlayerCacheData* data = sObjectMgr.GetPlayerDataByGUID(GetGUIDLow()))
-    {
-        data->uiLevel = GetLevel();
-        data->uiZoneId = GetCachedZoneId();
-    }
+    sObjectMgr.UpdatePlayerCachedLevelAndZone(GetGUIDLow(), GetLevel(), GetCachedZoneId());
+}
+
+Player::SaveStats Player::GetSaveStats()
+{
+    SaveStats stats;
+    stats.saves = s_saveCount;
+    stats.statements = s_saveStatements;
+    stats.maxStatements = s_saveMaxStatements;
+    return stats;
 }
 
 // fast save function for item/money cheating preventing - save only inventory and money state
@@ -16797,49 +16846,84 @@ void Player::SaveGoldToDB()
     stmt.PExecute(GetMoney(), GetGUIDLow());
 }
 
+static bool IsSameAuraRow(AuraSaveStruct const& a, AuraSaveStruct const& b)
+{
+    for (uint8 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        if (a.damage[i] != b.damage[i] || a.periodicTime[i] != b.periodicTime[i])
+            return false;
+
+    return a.stacks == b.stacks && a.charges == b.charges && a.maxDuration == b.maxDuration &&
+           a.duration == b.duration && a.effIndexMask == b.effIndexMask;
+}
+
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras ;
+    static SqlStatementID deleteAura ;
     static SqlStatementID insertAuras ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
+    std::map<SavedAuraKey, AuraSaveStruct> auras;
+    AuraSaveStruct s;
+    for (const auto& auraHolder : GetSpellAuraHolderMap())
+    {
+        if (SaveAura(auraHolder.second, s))
+            auras[SavedAuraKey(s.casterGuid.GetRawValue(), s.itemLowGuid, s.spellId)] = s;
+    }
 
-    SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
+    if (!m_savedAurasValid)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
+        stmt.PExecute(GetGUIDLow());
+        m_savedAuras.clear();
+        m_savedAurasValid = true;
+    }
+    else
+    {
+        // auras removed since the last save
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAura, "DELETE FROM `character_aura` WHERE `guid` = ? AND `caster_guid` = ? AND `item_guid` = ? AND `spell` = ?");
+        for (auto const& itr : m_savedAuras)
+        {
+            if (auras.find(itr.first) != auras.end())
+                continue;
 
-    if (auraHolders.empty())
-        return;
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt64(std::get<0>(itr.first));
+            stmt.addUInt32(std::get<1>(itr.first));
+            stmt.addUInt32(std::get<2>(itr.first));
+            stmt.Execute();
+        }
+    }
 
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stacks`, `charges`, "
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insertAuras, "REPLACE INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stacks`, `charges`, "
             "`base_points0`, `base_points1`, `base_points2`, `periodic_time0`, `periodic_time1`, `periodic_time2`, `max_duration`, `duration`, `effect_index_mask`) "
             "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
-    AuraSaveStruct s;
-    for (const auto& auraHolder : auraHolders)
+    for (auto const& itr : auras)
     {
-        SpellAuraHolder* holder = auraHolder.second;
-
-        if (!SaveAura(holder, s))
+        AuraSaveStruct const& aura = itr.second;
+        auto saved = m_savedAuras.find(itr.first);
+        if (saved != m_savedAuras.end() && IsSameAuraRow(saved->second, aura))
             continue;
 
         stmt.addUInt32(GetGUIDLow());
-        stmt.addUInt64(s.casterGuid.GetRawValue());
-        stmt.addUInt32(s.itemLowGuid);
-        stmt.addUInt32(s.spellId);
-        stmt.addUInt32(s.stacks);
-        stmt.addUInt8(s.charges);
+        stmt.addUInt64(aura.casterGuid.GetRawValue());
+        stmt.addUInt32(aura.itemLowGuid);
+        stmt.addUInt32(aura.spellId);
+        stmt.addUInt32(aura.stacks);
+        stmt.addUInt8(aura.charges);
 
-        for (float i : s.damage)
+        for (float i : aura.damage)
             stmt.addFloat(i);
 
-        for (uint32 i : s.periodicTime)
+        for (uint32 i : aura.periodicTime)
             stmt.addUInt32(i);
 
-        stmt.addInt32(s.maxDuration);
-        stmt.addInt32(s.duration);
-        stmt.addInt8(s.effIndexMask);
+        stmt.addInt32(aura.maxDuration);
+        stmt.addInt32(aura.duration);
+        stmt.addInt8(aura.effIndexMask);
         stmt.Execute();
     }
+    m_savedAuras.swap(auras);
 }
 
 bool Player::SaveAura(SpellAuraHolder* holder, AuraSaveStruct& saveStruct)
@@ -17140,15 +17224,17 @@ void Player::_SaveSpells()
     static SqlStatementID insSpells ;
 
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delSpells, "DELETE FROM `character_spell` WHERE `guid` = ? and `spell` = ?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "INSERT INTO `character_spell` (`guid`, `spell`, `active`, `disabled`) VALUES (?, ?, ?, ?)");
+    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "REPLACE INTO `character_spell` (`guid`, `spell`, `active`, `disabled`) VALUES (?, ?, ?, ?)");
 
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
-        if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
+        // add only changed/new not dependent spells, a changed row is replaced in place
+        bool const write = !itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED);
+
+        if (itr->second.state == PLAYERSPELL_REMOVED || (itr->second.state == PLAYERSPELL_CHANGED && !write))
             stmtDel.PExecute(GetGUIDLow(), itr->first);
 
-        // add only changed/new not dependent spells
-        if (!itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED))
+        if (write)
             stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(itr->second.active ? 1 : 0), uint8(itr->second.disabled ? 1 : 0));
 
         if (itr->second.state == PLAYERSPELL_REMOVED)
@@ -21912,6 +21998,7 @@ void Player::CreatePacketBroadcaster()
     ASSERT(!m_broadcaster);
     // Register player packet queue with the packet broadcaster
     m_broadcaster = std::make_shared<PlayerBroadcaster>(m_session->GetSocket(), GetObjectGuid());
+    m_broadcaster->SetPosition(GetPositionX(), GetPositionY());
     sWorld.GetBroadcaster()->RegisterPlayer(m_broadcaster);
 }
 
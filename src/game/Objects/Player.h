@@ -35,14 +35,15 @@
 #include "GameObjectDefines.h"
 #include "SpellMgr.h"
 #include "HonorMgr.h"
+#include "AuraSaveStruct.h"
 
 #include <string>
 #include <vector>
 #include <functional>
+#include <tuple>
 
 struct Mail;
 struct ItemPrototype;
-struct AuraSaveStruct;
 class Group;
 class Channel;
 class Creature;
@@ -1434,7 +1435,30 @@ class Player final: public Unit
         void _SaveBGData();
         void _SaveStats();
         uint32 m_nextSave;
+
+        // Rows written by the previous save: the next saves only write the rows that differ.
+        // Not valid before the first save, which rewrites the whole section.
+        typedef std::tuple<uint64, uint32, uint32> SavedAuraKey;     // caster_guid, item_guid, spell
+        std::map<SavedAuraKey, AuraSaveStruct> m_savedAuras;
+        bool m_savedAurasValid;
+        struct SavedCooldown
+        {
+            uint64 spellExpireTime;
+            uint32 category;
+            uint64 categoryExpireTime;
+            uint32 itemId;
+        };
+        std::map<uint32, SavedCooldown> m_savedCooldowns;
+        bool m_savedCooldownsValid;
     public:
+        struct SaveStats
+        {
+            uint64 saves;
+            uint64 statements;                              // statements of the save transactions
+            uint32 maxStatements;
+        };
+        // Totals since startup, for all the players
+        static SaveStats GetSaveStats();
         // Saves a new character directly in the database, without creating a Player object in memory.
         static bool SaveNewPlayer(WorldSession* session, uint32 guidlow, std::string const& name, uint8 raceId, uint8 classId, uint8 gender, uint8 skin, uint8 face, uint8 hairStyle, uint8 hairColor, uint8 facialHair);
         void SaveToDB(bool online = true, bool force = false);
@@ -66,44 +66,76 @@ void UpdateData::AddUpdateBlock(ByteBuffer const& block)
     ++it->blockCount;
 }
 
-void PacketCompressor::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    // One deflate stream per thread, reset between packets instead of allocating
+    // and freeing the zlib state (~270KB at level 1) for every compressed packet.
+    struct DeflateContext
+    {
+        z_stream stream;
+        int level = 0;
+
+        ~DeflateContext()
+        {
+            if (level)
+                deflateEnd(&stream);
+        }
+
+        bool Prepare(int wantedLevel)
+        {
+            if (level == wantedLevel)
+            {
+                int z_res = deflateReset(&stream);
+                if (z_res == Z_OK)
+                    return true;
+                sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                deflateEnd(&stream);
+                level = 0;
+            }
+            else if (level)
+            {
+                // Compression level changed on config reload
+                deflateEnd(&stream);
+                level = 0;
+            }
+
+            stream.zalloc = (alloc_func)0;
+            stream.zfree = (free_func)0;
+            stream.opaque = (voidpf)0;
+
+            int z_res = deflateInit(&stream, wantedLevel);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return false;
+            }
+            level = wantedLevel;
+            return true;
+        }
+    };
+
+    thread_local DeflateContext t_deflateContext;
+}
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+void PacketCompressor::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    DeflateContext& context = t_deflateContext;
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    if (!context.Prepare(sWorld.getConfig(CONFIG_UINT32_COMPRESSION)))
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
+    z_stream& c_stream = context.stream;
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
     c_stream.next_in = (Bytef*)src;
     c_stream.avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    if (c_stream.avail_in != 0)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
-
-    z_res = deflate(&c_stream, Z_FINISH);
+    // Whole packet is available, compress it in a single call
+    int z_res = deflate(&c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -111,17 +143,14 @@ void PacketCompressor::Compress(void* dst, uint32* dst_size, void* src, int src_
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
 }
 
+bool PacketCompressor::ShouldCompress(size_t size)
+{
+    return size > sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD);
+}
+
 bool UpdateData::BuildPacket(WorldPacket* packet, bool hasTransport)
 {
     if (m_datas.empty())
@@ -158,7 +187,7 @@ bool UpdateData::BuildPacket(WorldPacket* packet, UpdatePacket const* updPacket,
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                       // compress large packets
+    if (PacketCompressor::ShouldCompress(pSize))           // compress large packets
     {
         if (pSize >= 900000)
             sLog.outInfo("[CRASH-CLIENT] Too large packet: %u", pSize);
@@ -68,6 +68,8 @@ class PacketCompressor
 {
     public:
         static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        // Packets up to Compression.Threshold bytes are cheaper to send as is
+        static bool ShouldCompress(size_t size);
 };
 
 class UpdateData
@@ -9,8 +9,9 @@ bool ChatHandler::HandlePBCastStatsCommand(char*)
     auto const& stats = bcaster->GetStats();
     PSendSysMessage("PacketBroadcast: %u threads.", stats.size());
     for (int i = 0; i < stats.size(); ++i)
-        PSendSysMessage("Thread #%02u: Update %03ums | %u packets",
-            i, stats[i].update_time, stats[i].num_packets);
+        PSendSysMessage("Thread #%02u: Update %03ums | %u packets | %u players | %u B/player/s (%u B/player/s without LOD)",
+            i, stats[i].update_time, stats[i].num_packets, stats[i].num_players, stats[i].bytes_per_player_sec,
+            stats[i].bytes_per_player_sec + stats[i].skipped_bytes_per_player_sec);
     PSendSysMessage("Created %u broadcasters | Deleted %u",
         PlayerBroadcaster::num_bcaster_created, PlayerBroadcaster::num_bcaster_deleted);
     return true;
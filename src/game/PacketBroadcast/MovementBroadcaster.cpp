@@ -28,7 +28,7 @@ void MovementBroadcaster::StartThreads()
     std::vector<std::mutex> locks(m_num_threads);
     m_thread_locks = std::move(locks);
     m_thread_players.resize(m_num_threads);
-    m_thread_update_stats.resize(m_num_threads);
+    m_thread_update_stats.assign(m_num_threads, ThreadUpdateStats());
 
     m_stop = false;
 
@@ -63,15 +63,33 @@ void MovementBroadcaster::RemovePlayer(std::shared_ptr<PlayerBroadcaster> const&
 
 void MovementBroadcaster::Work(std::size_t thread_id)
 {
+    // Bytes counters, reported once per second
+    uint32 window_start = WorldTimer::getMSTime();
+    uint64 window_bytes_sent = 0;
+    uint64 window_bytes_skipped = 0;
+
     while (!m_stop)
     {
         ThreadUpdateStats& stats = m_thread_update_stats[thread_id];
         uint32 num_packets = 0;
+        uint32 num_players = 0;
         uint32 begin_time = WorldTimer::getMSTime();
-        BroadcastPackets(thread_id, num_packets);
+        BroadcastPackets(thread_id, num_packets, window_bytes_sent, window_bytes_skipped, num_players);
         stats.num_packets = num_packets;
         stats.update_time = WorldTimer::getMSTimeDiffToNow(begin_time);
 
+        uint32 window_time = WorldTimer::getMSTimeDiff(window_start, WorldTimer::getMSTime());
+        if (window_time >= 1000)
+        {
+            uint64 divisor = uint64(std::max<uint32>(num_players, 1)) * window_time;
+            stats.num_players = num_players;
+            stats.bytes_per_player_sec = uint32(window_bytes_sent * 1000 / divisor);
+            stats.skipped_bytes_per_player_sec = uint32(window_bytes_skipped * 1000 / divisor);
+            window_start = WorldTimer::getMSTime();
+            window_bytes_sent = 0;
+            window_bytes_skipped = 0;
+        }
+
         if (sWorld.getConfig(CONFIG_UINT32_PERFLOG_SLOW_PACKET_BCAST) &&
             stats.update_time > sWorld.getConfig(CONFIG_UINT32_PERFLOG_SLOW_PACKET_BCAST))
             sLog.out(LOG_PERFORMANCE, "MovementBroadcaster thread %02u: %04ums to process queue [%u packets]",
@@ -107,7 +125,7 @@ uint32 MovementBroadcaster::IdentifySlowMap(std::size_t thread_id)
     return max_instance_id;
 }
 
-void MovementBroadcaster::BroadcastPackets(std::size_t index, uint32& num_packets)
+void MovementBroadcaster::BroadcastPackets(std::size_t index, uint32& num_packets, uint64& bytes_sent, uint64& bytes_skipped, uint32& num_players)
 {
     PlayersBCastSet my_players;
     {
@@ -115,8 +133,14 @@ void MovementBroadcaster::BroadcastPackets(std::size_t index, uint32& num_packet
         my_players = m_thread_players[index];
     }
 
+    PlayerBroadcaster::ProcessStats process_stats = {};
     for (auto& player : my_players)
-        player->ProcessQueue(num_packets);
+        player->ProcessQueue(process_stats);
+
+    num_packets += process_stats.packets;
+    bytes_sent += process_stats.bytesSent;
+    bytes_skipped += process_stats.bytesSkipped;
+    num_players = my_players.size();
 }
 
 void MovementBroadcaster::Stop()
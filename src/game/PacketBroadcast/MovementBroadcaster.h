@@ -25,7 +25,7 @@ class MovementBroadcaster final
     std::vector<std::mutex> m_thread_locks;
 
     void Work(std::size_t thread_id);
-    void BroadcastPackets(std::size_t index, uint32& num_packets);
+    void BroadcastPackets(std::size_t index, uint32& num_packets, uint64& bytes_sent, uint64& bytes_skipped, uint32& num_players);
     uint32 IdentifySlowMap(std::size_t thread_id);
 
 public:
@@ -44,6 +44,11 @@ public:
         uint32 update_time;
         uint32 num_packets;
         int32 slow_instance;
+        // Averaged over the last second. Without the distance LOD, each player
+        // would receive bytes_per_player_sec + skipped_bytes_per_player_sec.
+        uint32 num_players;
+        uint32 bytes_per_player_sec;
+        uint32 skipped_bytes_per_player_sec;
     };
     std::vector<ThreadUpdateStats> const& GetStats() const { return m_thread_update_stats; }
     std::chrono::milliseconds GetSleepTimer() const { return m_sleep_timer; }
@@ -3,12 +3,15 @@
 #include "WorldPacket.h"
 #include "WorldSocket.h"
 #include "Player.h"
+#include "World.h"
+#include "Timer.h"
 
 uint32 PlayerBroadcaster::num_bcaster_created = 0;
 uint32 PlayerBroadcaster::num_bcaster_deleted = 0;
 
 PlayerBroadcaster::PlayerBroadcaster(WorldSocket* w_socket, ObjectGuid const& self, std::size_t max_queue)
-    : MAX_QUEUE_SIZE(max_queue), m_socket(w_socket), m_self(self), instanceId(0), lastUpdatePackets(0)
+    : MAX_QUEUE_SIZE(max_queue), m_socket(w_socket), m_self(self), m_positionX(0.0f), m_positionY(0.0f),
+      instanceId(0), lastUpdatePackets(0)
 {
     if (m_socket)
         m_socket->AddReference();
@@ -33,7 +36,9 @@ void PlayerBroadcaster::AddListener(Player const* player)
         return;
 
     std::lock_guard<std::mutex> guard(m_listeners_lock);
-    m_listeners[player->GetObjectGuid()] = player->m_broadcaster;
+    ListenerData& listener = m_listeners[player->GetObjectGuid()];
+    listener.broadcaster = player->m_broadcaster;
+    listener.lastFarHeartbeat = 0;
 }
 
 void PlayerBroadcaster::RemoveListener(Player const* player)
@@ -49,13 +54,19 @@ void PlayerBroadcaster::ClearListeners()
     m_listeners.clear();
 }
 
-void PlayerBroadcaster::SendPacket(WorldPacket const& packet)
+void PlayerBroadcaster::SendPacket(SharedWorldPacket const& packet)
 {
     if (m_socket)
         m_socket->SendPacket(packet);
 }
 
-void PlayerBroadcaster::ProcessQueue(uint32& num_packets)
+void PlayerBroadcaster::SetPosition(float x, float y)
+{
+    m_positionX.store(x, std::memory_order_relaxed);
+    m_positionY.store(y, std::memory_order_relaxed);
+}
+
+void PlayerBroadcaster::ProcessQueue(ProcessStats& stats)
 {
     if (m_queue.empty())
         return;
@@ -64,29 +75,68 @@ void PlayerBroadcaster::ProcessQueue(uint32& num_packets)
     auto queue = std::move(m_queue);
     q_g.unlock();
 
-    lastUpdatePackets = queue.size() * m_listeners.size();
-    num_packets += lastUpdatePackets;
+    // Heartbeats to the listeners beyond the near distance are rate limited. The other
+    // movement packets always go through, so far clients still see every start and stop.
+    uint32 const farHeartbeatInterval = sWorld.getConfig(CONFIG_UINT32_PBCAST_LOD_FAR_HEARTBEAT_INTERVAL);
+    uint32 const now = WorldTimer::getMSTime();
+    float const nearDistance = sWorld.getConfig(CONFIG_FLOAT_PBCAST_LOD_NEAR_DISTANCE);
+    float const x = m_positionX.load(std::memory_order_relaxed);
+    float const y = m_positionY.load(std::memory_order_relaxed);
+
+    // Header added by the socket: size (2) + opcode (2)
+    std::size_t const headerSize = 4;
+    uint32 sentPackets = 0;
 
     for (auto& data : queue)
     {
+        std::size_t const bytes = data.packet->size() + headerSize;
+        bool const rateLimited = farHeartbeatInterval && data.packet->GetOpcode() == MSG_MOVE_HEARTBEAT;
+
         // Send to self?
         if (data.sendToSelf && data.except != GetGUID())
+        {
             SendPacket(data.packet);
+            stats.bytesSent += bytes;
+            ++sentPackets;
+        }
 
         for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
         {
             if (it->first == data.except)
                 continue;
 
-            it->second->SendPacket(data.packet);
+            ListenerData& listener = it->second;
+            if (rateLimited)
+            {
+                float const dx = listener.broadcaster->m_positionX.load(std::memory_order_relaxed) - x;
+                float const dy = listener.broadcaster->m_positionY.load(std::memory_order_relaxed) - y;
+                if (dx * dx + dy * dy > nearDistance * nearDistance)
+                {
+                    if (WorldTimer::getMSTimeDiff(listener.lastFarHeartbeat, now) < farHeartbeatInterval)
+                    {
+                        stats.bytesSkipped += bytes;
+                        continue;
+                    }
+                    listener.lastFarHeartbeat = now;
+                }
+            }
+
+            listener.broadcaster->SendPacket(data.packet);
+            stats.bytesSent += bytes;
+            ++sentPackets;
         }
     }
+
+    lastUpdatePackets = sentPackets;
+    stats.packets += sentPackets;
 }
 
 void PlayerBroadcaster::QueuePacket(WorldPacket packet, bool self, ObjectGuid except)
 {
+    uint16 const opcode = packet.GetOpcode();
+
     BroadcastData data;
-    data.packet = std::move(packet);
+    data.packet = MakeSharedPacket(std::move(packet));
     data.sendToSelf = self;
     data.except = except;
 
@@ -98,7 +148,7 @@ void PlayerBroadcaster::QueuePacket(WorldPacket packet, bool self, ObjectGuid ex
     if (m_queue.size() >= MAX_QUEUE_SIZE)
     {
         BroadcastData& last_in_queue = m_queue[m_queue.size() - 1];
-        if (CanSkipPacket(last_in_queue.packet.GetOpcode()) && CanSkipPacket(packet.GetOpcode()))
+        if (CanSkipPacket(last_in_queue.packet->GetOpcode()) && CanSkipPacket(opcode))
         {
             m_queue[m_queue.size() - 1] = std::move(data);
             guard.unlock();
@@ -4,6 +4,7 @@
 #include "ObjectGuid.h"
 #include "WorldPacket.h"
 #include "Opcodes.h"
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <cstddef>
@@ -16,23 +17,40 @@ class PlayerBroadcaster final
 {
     struct BroadcastData
     {
-        WorldPacket packet;
+        SharedWorldPacket packet;                           // same payload for every listener
         bool sendToSelf;
         ObjectGuid except;
     };
 
+    struct ListenerData
+    {
+        std::shared_ptr<PlayerBroadcaster> broadcaster;
+        uint32 lastFarHeartbeat;                            // last heartbeat relayed while far away
+    };
+
     std::size_t const MAX_QUEUE_SIZE;
 
     WorldSocket* m_socket;
     ObjectGuid m_self;
 
-    std::map<ObjectGuid, std::shared_ptr<PlayerBroadcaster> > m_listeners;
+    std::map<ObjectGuid, ListenerData> m_listeners;
     std::vector<BroadcastData> m_queue;
     std::mutex m_listeners_lock;
     std::mutex m_queue_lock;
 
-    void ProcessQueue(uint32& num_packets);
-    void SendPacket(WorldPacket const& packet);
+    // Last known position of the player, read by the other broadcaster threads
+    std::atomic<float> m_positionX;
+    std::atomic<float> m_positionY;
+
+    struct ProcessStats
+    {
+        uint32 packets;
+        uint64 bytesSent;
+        uint64 bytesSkipped;                                // heartbeats not relayed to far listeners
+    };
+
+    void ProcessQueue(ProcessStats& stats);
+    void SendPacket(SharedWorldPacket const& packet);
 
     static inline bool CanSkipPacket(uint32 opcode)
     {
@@ -63,6 +81,7 @@ public:
 
     void ClearListeners();
     void SetInstanceId(uint32 id) { instanceId = id; }
+    void SetPosition(float x, float y);
 
     friend class MovementBroadcaster;
 };
@@ -84,8 +84,8 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
                     aptr.release();
                     // WARNINIG here we call it with locks held.
                     // Its possible to cause deadlock if QueuePacket calls back
-                    m_Session->QueuePacket(new_pct);
-                    return 0;
+                    // A full receive queue is flooding: close the connection
+                    return m_Session->QueuePacket(new_pct) ? 0 : -1;
                 }
                 else
                 {
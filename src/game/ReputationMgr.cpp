@@ -446,19 +446,16 @@ void ReputationMgr::LoadFromDB(QueryResult* result)
 
 void ReputationMgr::SaveToDB()
 {
-    static SqlStatementID delRep ;
-    static SqlStatementID insRep ;
+    static SqlStatementID replaceRep ;
 
-    SqlStatement stmtDel = CharacterDatabase.CreateStatement(delRep, "DELETE FROM character_reputation WHERE guid = ? AND faction=?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insRep, "INSERT INTO character_reputation (guid,faction,standing,flags) VALUES (?, ?, ?, ?)");
+    SqlStatement stmt = CharacterDatabase.CreateStatement(replaceRep, "REPLACE INTO character_reputation (guid,faction,standing,flags) VALUES (?, ?, ?, ?)");
 
     for (auto& itr : m_factions)
     {
         FactionState& faction = itr.second;
         if (faction.needSave)
         {
-            stmtDel.PExecute(m_player->GetGUIDLow(), faction.ID);
-            stmtIns.PExecute(m_player->GetGUIDLow(), faction.ID, faction.Standing, faction.Flags);
+            stmt.PExecute(m_player->GetGUIDLow(), faction.ID, faction.Standing, faction.Flags);
             faction.needSave = false;
         }
     }
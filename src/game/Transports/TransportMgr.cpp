@@ -44,10 +44,11 @@ TransportTemplate* TransportMgr::GetTransportTemplate(uint32 entry)
 
 void TransportMgr::LoadTransportTemplates()
 {
-    for (uint32 entry = 1; entry <= sGOStorage.GetMaxEntry(); ++entry)
+    for (auto itr = sGOStorage.begin<GameObjectInfo>(); itr < sGOStorage.end<GameObjectInfo>(); ++itr)
     {
-        auto data = sGOStorage.LookupEntry<GameObjectInfo>(entry);
-        if (data && data->type == GAMEOBJECT_TYPE_MO_TRANSPORT)
+        GameObjectInfo const* data = *itr;
+        uint32 const entry = data->id;
+        if (data->type == GAMEOBJECT_TYPE_MO_TRANSPORT)
         {
             TransportTemplate& transportTemplate = m_transportTemplates[entry];
             transportTemplate.entry = entry;
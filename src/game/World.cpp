@@ -55,6 +55,7 @@
 #include "GameEventMgr.h"
 #include "PoolManager.h"
 #include "Database/DatabaseImpl.h"
+#include "Database/SqlBatchWriter.h"
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
 #include "MapPersistentStateMgr.h"
@@ -76,11 +77,12 @@
 #include "MovementBroadcaster.h"
 #include "HonorMgr.h"
 #include "Anticheat/Anticheat.h"
-#include "ThreadPool.h"
+#include "TaskScheduler.h"
 #include "AuraRemovalMgr.h"
 #include "InstanceStatistics.h"
 #include "GuardMgr.h"
 #include "TransportMgr.h"
+#include "StartupLoader.h"
 
 #include <chrono>
 
@@ -122,7 +124,8 @@ World::World():
     m_startTime(m_gameTime),
     m_wowPatch(WOW_PATCH_102),
     m_defaultDbcLocale(LOCALE_enUS),
-    m_timeRate(1.0f)
+    m_timeRate(1.0f),
+    m_logsWriter(new SqlBatchWriter(LogsDatabase))
 {
     m_ShutdownMask = 0;
     m_ShutdownTimer = 0;
@@ -384,6 +387,19 @@ bool World::RemoveQueuedSession(WorldSession* sess)
     return found;
 }
 
+std::vector<float> const& World::GetContinentRegionBounds(uint32 mapId) const
+{
+    static std::vector<float> const noRegions;
+    switch (mapId)
+    {
+        case 0:
+        case 1:
+            return m_continentRegionBounds[mapId];
+        default:
+            return noRegions;
+    }
+}
+
 /// Initialize config values
 void World::LoadConfigSettings(bool reload)
 {
@@ -516,6 +532,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHARACTER_SCREEN_MAX_IDLE_TIME, "CharacterScreenMaxIdleTime", 0);
     setConfig(CONFIG_UINT32_ASYNC_QUERIES_TICK_TIMEOUT, "AsyncQueriesTickTimeout", 0);
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfigMinMax(CONFIG_UINT32_COMPRESSION_THRESHOLD, "Compression.Threshold", 100, 0, 0x8000);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -858,6 +875,14 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Read the directory of the world table snapshots
+    std::string snapshotPath = sConfig.GetStringDefault("WorldDatabase.SnapshotDir", "");
+    if (!snapshotPath.empty() && snapshotPath.at(snapshotPath.length() - 1) != '/' && snapshotPath.at(snapshotPath.length() - 1) != '\\')
+        snapshotPath.append("/");
+    SQLStorageBase::SetSnapshotDirectory(snapshotPath);
+    if (!snapshotPath.empty())
+        sLog.outString("Using world table snapshots in %s", snapshotPath.c_str());
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -876,13 +901,26 @@ void World::LoadConfigSettings(bool reload)
     sLog.outString("WORLD: mmap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
 
     setConfig(CONFIG_UINT32_EMPTY_MAPS_UPDATE_TIME, "MapUpdate.Empty.UpdateTime", 0);
+    setConfigMinMax(CONFIG_UINT32_MAPUPDATE_ADAPTIVE_MAX_INTERVAL, "MapUpdate.Adaptive.MaxInterval", 0, 0, 2000);
+    setConfig(CONFIG_UINT32_MAPUPDATE_ADAPTIVE_DENSE_PLAYERS, "MapUpdate.Adaptive.DensePlayers", 5);
     setConfigMinMax(CONFIG_UINT32_MAP_OBJECTSUPDATE_THREADS, "MapUpdate.ObjectsUpdate.MaxThreads", 4, 1, 20);
     setConfigMinMax(CONFIG_UINT32_MAP_OBJECTSUPDATE_TIMEOUT, "MapUpdate.ObjectsUpdate.Timeout", 100, 10, 2000);
     setConfigMinMax(CONFIG_UINT32_MAP_VISIBILITYUPDATE_THREADS, "MapUpdate.VisibilityUpdate.MaxThreads", 4, 1, 20);
     setConfigMinMax(CONFIG_UINT32_MAP_VISIBILITYUPDATE_TIMEOUT, "MapUpdate.VisibilityUpdate.Timeout", 100, 10, 2000);
-    setConfigMinMax(CONFIG_UINT32_MAPUPDATE_INSTANCED_UPDATE_THREADS, "MapUpdate.Instanced.UpdateThreads", 2, 0, 20);
+    setConfigMinMax(CONFIG_UINT32_MAPUPDATE_SCHEDULER_THREADS, "MapUpdate.Scheduler.Threads", 0, 0, 64);
+    setConfigMinMax(CONFIG_UINT32_STARTUP_LOADER_THREADS, "StartupLoader.Threads", 4, 1, 16);
     setConfigMinMax(CONFIG_UINT32_MTCELLS_THREADS, "MapUpdate.Continents.MTCells.Threads", 0, 0, 20);
     setConfigMinMax(CONFIG_UINT32_MTCELLS_SAFEDISTANCE, "MapUpdate.Continents.MTCells.SafeDistance", 1066, 0, 34112);
+    for (uint32 mapId = 0; mapId < MAX_CONTINENT_REGION_MAPS; ++mapId)
+    {
+        std::string const key = "MapUpdate.Continents.Regions.Map" + std::to_string(mapId);
+        m_continentRegionBounds[mapId].clear();
+        for (std::string const& bound : StrSplit(sConfig.GetStringDefault(key.c_str(), ""), " "))
+            m_continentRegionBounds[mapId].push_back(float(atof(bound.c_str())));
+        std::sort(m_continentRegionBounds[mapId].begin(), m_continentRegionBounds[mapId].end());
+        if (!m_continentRegionBounds[mapId].empty())
+            sLog.outString("Map %u updated in %u regions", mapId, uint32(m_continentRegionBounds[mapId].size() + 1));
+    }
     setConfigMinMax(CONFIG_UINT32_MAPUPDATE_UPDATE_PACKETS_DIFF, "MapUpdate.UpdatePacketsDiff", 100, 1, 10000);
     setConfigMinMax(CONFIG_UINT32_MAPUPDATE_UPDATE_PLAYERS_DIFF, "MapUpdate.UpdatePlayersDiff", 100, 1, 10000);
     setConfigMinMax(CONFIG_UINT32_MAPUPDATE_UPDATE_CELLS_DIFF, "MapUpdate.UpdateCellsDiff", 100, 1, 10000);
@@ -933,6 +971,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_PERFLOG_SLOW_MAP_PACKETS, "PerformanceLog.SlowMapPackets", 60);
     setConfig(CONFIG_UINT32_PERFLOG_SLOW_SESSIONS_UPDATE, "PerformanceLog.SlowSessionsUpdate", 0);
     setConfig(CONFIG_UINT32_PERFLOG_SLOW_PACKET_BCAST, "PerformanceLog.SlowPacketBroadcast", 0);
+    setConfig(CONFIG_BOOL_PERFLOG_MAP_TICK_INTERVAL, "PerformanceLog.MapTickInterval", false);
     setConfig(CONFIG_UINT32_LOG_MONEY_TRADES_TRESHOLD, "LogMoneyTreshold", 10000);
 
     setConfig(CONFIG_FLOAT_DYN_RESPAWN_CHECK_RANGE, "DynamicRespawn.Range", -1.0f);
@@ -967,6 +1006,12 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_LOGSDB_CHAT, "LogsDB.Chat", 1);
     setConfig(CONFIG_BOOL_LOGSDB_TRADES, "LogsDB.Trades", 1);
     setConfig(CONFIG_BOOL_LOGSDB_TRANSACTIONS, "LogsDB.Transactions", 0);
+    setConfigMinMax(CONFIG_UINT32_LOGSDB_BATCH_MAX_ROWS, "LogsDB.Batch.MaxRows", 100, 0, 10000);
+    setConfigMinMax(CONFIG_UINT32_LOGSDB_BATCH_MAX_BYTES, "LogsDB.Batch.MaxBytes", 65536, 1024, 16 * 1024 * 1024);
+    setConfig(CONFIG_UINT32_LOGSDB_BATCH_MAX_DELAY, "LogsDB.Batch.MaxDelay", 1000);
+    setConfig(CONFIG_UINT32_LOGSDB_BATCH_MAX_DB_QUEUE, "LogsDB.Batch.MaxDbQueue", 1000);
+    m_logsWriter->SetLimits(getConfig(CONFIG_UINT32_LOGSDB_BATCH_MAX_ROWS), getConfig(CONFIG_UINT32_LOGSDB_BATCH_MAX_BYTES),
+        getConfig(CONFIG_UINT32_LOGSDB_BATCH_MAX_DELAY), getConfig(CONFIG_UINT32_LOGSDB_BATCH_MAX_DB_QUEUE));
     setConfig(CONFIG_BOOL_SMARTLOG_DEATH, "Smartlog.Death", 1);
     setConfig(CONFIG_BOOL_SMARTLOG_LONGCOMBAT, "Smartlog.LongCombat", 1);
     setConfig(CONFIG_BOOL_SMARTLOG_SCRIPTINFO, "Smartlog.ScriptInfo", 1);
@@ -982,10 +1027,12 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_MAILSPAM_ITEM, "MailSpam.Item", false);
     setConfig(CONFIG_UINT32_COD_FORCE_TAG_MAX_LEVEL, "Mails.COD.ForceTag.MaxLevel", 0);
 
-    setConfigMinMax(CONFIG_UINT32_ASYNC_TASKS_THREADS_COUNT,       "AsyncTasks.Threads", 1, 1, 20);
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,               "Network.KickOnBadPacket", false);
     setConfig(CONFIG_UINT32_PACKET_BCAST_THREADS,                  "Network.PacketBroadcast.Threads", 0);
     setConfig(CONFIG_UINT32_PACKET_BCAST_FREQUENCY,                "Network.PacketBroadcast.Frequency", 50);
+    setConfig(CONFIG_FLOAT_PBCAST_LOD_NEAR_DISTANCE,               "Network.PacketBroadcast.LOD.NearDistance", 30.0f);
+    setConfig(CONFIG_UINT32_PBCAST_LOD_FAR_HEARTBEAT_INTERVAL,     "Network.PacketBroadcast.LOD.FarHeartbeatInterval", 1500);
+    setConfigMinMax(CONFIG_UINT32_SESSION_RECV_QUEUE_SIZE,         "Network.RecvQueueSize", 1024, 16, 65536);
     setConfig(CONFIG_UINT32_PBCAST_DIFF_LOWER_VISIBILITY_DISTANCE, "Network.PacketBroadcast.ReduceVisDistance.DiffAbove", 0);
     
     sLog.outString("* Anticrash : options 0x%x rearm after %usec", getConfig(CONFIG_UINT32_ANTICRASH_OPTIONS), getConfig(CONFIG_UINT32_ANTICRASH_REARM_TIMER) / 1000);
@@ -1203,6 +1250,12 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    ///- Spawn the workers shared by the map updates
+    m_updateScheduler.reset(new TaskScheduler(getConfig(CONFIG_UINT32_MAPUPDATE_SCHEDULER_THREADS),
+        []() { WorldDatabase.ThreadStart(); },              // let the workers do safe mySQL requests
+        []() { WorldDatabase.ThreadEnd(); }));
+    sLog.outString("Using %u update threads", uint32(m_updateScheduler->size()));
+
     ///- Check the existence of the map files for all races start areas.
     if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f) ||
             !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f) ||
@@ -1541,41 +1594,33 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading Skill Fishing base level requirements...");
     sObjectMgr.LoadFishingBaseSkillLevel();
 
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadNPCText
-
-    sLog.outString("Loading Gossip scripts...");
-    sScriptMgr.LoadGossipScripts();                         // must be before gossip menu options
-
-    sObjectMgr.LoadGossipMenus();
-
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
-
-    sLog.outString("Loading Waypoint scripts...");          // before loading from creature_movement
-    sScriptMgr.LoadCreatureMovementScripts();
-
-    sLog.outString("Loading Waypoints...");
-    sLog.outString();
-    sWaypointMgr.Load();
-
-    ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadBroadcastTextLocales();
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sObjectMgr.LoadAreaLocales();
-    sLog.outString(">>> Localization strings loaded");
+    ///- Tables read by the npcs, loaded together (see StartupLoader.Threads)
+    sLog.outString("Loading Gossips, Vendors, Trainers, Waypoints and Localization strings...");
+    StartupLoader npcLoaders;
+    npcLoaders.Add("Npc Text Id", []() { sObjectMgr.LoadNpcGossips(); });          // must be after load Creature and LoadNPCText
+    npcLoaders.Add("Gossip scripts", []() { sScriptMgr.LoadGossipScripts(); });
+    npcLoaders.Add("Gossip menus", []() { sObjectMgr.LoadGossipMenus(); }, { "Gossip scripts" });
+    npcLoaders.Add("Vendor templates", []() { sObjectMgr.LoadVendorTemplates(); }); // must be after load ItemTemplate
+    npcLoaders.Add("Vendors", []() { sObjectMgr.LoadVendors(); }, { "Vendor templates" });
+    npcLoaders.Add("Trainer templates", []() { sObjectMgr.LoadTrainerTemplates(); });
+    npcLoaders.Add("Trainers", []() { sObjectMgr.LoadTrainers(); }, { "Trainer templates" });
+    npcLoaders.Add("Waypoint scripts", []() { sScriptMgr.LoadCreatureMovementScripts(); });
+    npcLoaders.Add("Waypoints", []() { sWaypointMgr.Load(); }, { "Waypoint scripts" });
+    // One loader: they all register their locales in the same index (GetOrNewIndexForLocale)
+    npcLoaders.Add("Localization strings", []()
+    {
+        sObjectMgr.LoadBroadcastTextLocales();
+        sObjectMgr.LoadCreatureLocales();                   // must be after CreatureInfo loading
+        sObjectMgr.LoadGameObjectLocales();                 // must be after GameobjectInfo loading
+        sObjectMgr.LoadItemLocales();                       // must be after ItemPrototypes loading
+        sObjectMgr.LoadQuestLocales();                      // must be after QuestTemplates loading
+        sObjectMgr.LoadPageTextLocales();                   // must be after PageText loading
+        sObjectMgr.LoadGossipMenuItemsLocales();            // must be after gossip menu items loading
+        sObjectMgr.LoadPointOfInterestLocales();            // must be after POI loading
+        sObjectMgr.LoadAreaLocales();
+    }, { "Gossip menus" });
+    npcLoaders.Run(getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS));
+    sLog.outString(">>> Gossips, Vendors, Trainers, Waypoints and Localization strings loaded");
     sLog.outString();
 
     ///- Load dynamic data tables from the database
@@ -1775,6 +1820,8 @@ void World::SetInitialWorldSettings()
     sLog.outString("==========================================================");
     sLog.outString();
 
+    npcLoaders.PrintTimeline();
+
     sLog.outString("World initialized.");
 
     uint32 uStartInterval = WorldTimer::getMSTimeDiff(uStartTime, WorldTimer::getMSTime());
@@ -1847,6 +1894,9 @@ void World::Update(uint32 diff)
     ///-Update mass mailer tasks if any
     sMassMailMgr.Update();
 
+    ///- Write the batches of log rows waiting for too long
+    m_logsWriter->Update(diff);
+
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
@@ -1878,21 +1928,15 @@ void World::Update(uint32 diff)
     ///- Update objects (maps, transport, creatures,...)
     uint32 updateMapSystemTime = WorldTimer::getMSTime();
     
-    //TODO: find a better place for this
-    if (!m_updateThreads)
-    {
-        m_updateThreads = std::unique_ptr<ThreadPool>( new ThreadPool(
-                    getConfig(CONFIG_UINT32_ASYNC_TASKS_THREADS_COUNT),
-                    ThreadPool::ClearMode::UPPON_COMPLETION)
-                                             );
-        m_updateThreads->start<ThreadPool::MySQL<>>();
-    }
+    TaskScheduler::TaskGroup asyncTasks;
     std::unique_lock<std::mutex> lock(m_asyncTaskQueueMutex);
     _asyncTasks.swap(_asyncTasksBusy);
-    std::future<void> job = m_updateThreads->processWorkload(_asyncTasksBusy);
     _asyncTasks.clear();
     lock.unlock();
-    
+    for (auto& task : _asyncTasksBusy)
+        m_updateScheduler->spawn(asyncTasks, std::move(task));
+    _asyncTasksBusy.clear();
+
     sMapMgr.Update(diff);
     sBattleGroundMgr.Update(diff);
     sLFGMgr.Update(diff);
@@ -1912,8 +1956,7 @@ void World::Update(uint32 diff)
 
     uint32 asyncWaitBegin = WorldTimer::getMSTime();
 
-    if (job.valid())
-        job.wait();
+    m_updateScheduler->wait(asyncTasks);
 
     updateMapSystemTime = WorldTimer::getMSTimeDiffToNow(updateMapSystemTime);
     if (getConfig(CONFIG_UINT32_PERFLOG_SLOW_MAPSYSTEM_UPDATE) && updateMapSystemTime > getConfig(CONFIG_UINT32_PERFLOG_SLOW_MAPSYSTEM_UPDATE))
@@ -2337,7 +2380,7 @@ BanReturn World::BanAccount(BanMode mode, std::string nameOrIP, uint32 duration_
     std::string safe_author = author;
     LoginDatabase.escape_string(safe_author);
 
-    PlayerCacheData* authorData = sObjectMgr.GetPlayerDataByName(author);
+    PlayerCacheDataPtr authorData = sObjectMgr.GetPlayerDataByName(author);
 
     BanQueryHolder* holder = new BanQueryHolder(mode, nameOrIP, duration_secs, reason, realmID, safe_author,
         authorData ? authorData->uiAccount : 0);
@@ -2858,16 +2901,16 @@ void World::LogMoneyTrade(ObjectGuid sender, ObjectGuid receiver, uint32 amount,
 {
     if (!LogsDatabase || !sWorld.getConfig(CONFIG_BOOL_LOGSDB_TRADES))
         return;
-    static SqlStatementID insLogMoney;
-    SqlStatement logStmt = LogsDatabase.CreateStatement(insLogMoney, "INSERT INTO `logs_trade` SET `sender`=?, `senderType`=?, `senderEntry`=?, `receiver`=?, `amount`=?, `type`=?, `data`=?");
-    logStmt.addUInt32(sender.GetCounter());
-    logStmt.addUInt32(sender.GetHigh());
-    logStmt.addUInt32(sender.GetEntry());
-    logStmt.addUInt32(receiver.GetCounter());
-    logStmt.addUInt32(amount);
-    logStmt.addString(type);
-    logStmt.addUInt32(dataInt);
-    logStmt.Execute();
+    SqlBatchRow row(LogsDatabase);
+    row.addUInt32(sender.GetCounter());
+    row.addUInt32(sender.GetHigh());
+    row.addUInt32(sender.GetEntry());
+    row.addUInt32(receiver.GetCounter());
+    row.addUInt32(amount);
+    row.addString(type);
+    row.addUInt32(dataInt);
+    row.addTime(time(nullptr));
+    m_logsWriter->Insert("INSERT INTO `logs_trade` (`sender`, `senderType`, `senderEntry`, `receiver`, `amount`, `type`, `data`, `time`) VALUES ", row);
 }
 
 void World::LogCharacter(Player* character, char const* action)
@@ -2875,14 +2918,7 @@ void World::LogCharacter(Player* character, char const* action)
     if (!LogsDatabase || !sWorld.getConfig(CONFIG_BOOL_LOGSDB_CHARACTERS))
         return;
     ASSERT(character);
-    static SqlStatementID insLogChar;
-    SqlStatement logStmt = LogsDatabase.CreateStatement(insLogChar, "INSERT INTO `logs_characters` SET `type`=?, `guid`=?, `account`=?, `name`=?, `ip`=?");
-    logStmt.addString(action);
-    logStmt.addUInt32(character->GetGUIDLow());
-    logStmt.addUInt32(character->GetSession()->GetAccountId());
-    logStmt.addString(character->GetName());
-    logStmt.addString(character->GetSession()->GetRemoteAddress());
-    logStmt.Execute();
+    LogCharacter(character->GetSession(), character->GetGUIDLow(), character->GetName(), action);
 }
 
 void World::LogCharacter(WorldSession* sess, uint32 lowGuid, std::string const& charName, char const* action)
@@ -2890,14 +2926,14 @@ void World::LogCharacter(WorldSession* sess, uint32 lowGuid, std::string const&
     if (!LogsDatabase || !sWorld.getConfig(CONFIG_BOOL_LOGSDB_CHARACTERS))
         return;
     ASSERT(sess);
-    static SqlStatementID insLogChar;
-    SqlStatement logStmt = LogsDatabase.CreateStatement(insLogChar, "INSERT INTO `logs_characters` SET `type`=?, `guid`=?, `account`=?, `name`=?, `ip`=?");
-    logStmt.addString(action);
-    logStmt.addUInt32(lowGuid);
-    logStmt.addUInt32(sess->GetAccountId());
-    logStmt.addString(charName);
-    logStmt.addString(sess->GetRemoteAddress());
-    logStmt.Execute();
+    SqlBatchRow row(LogsDatabase);
+    row.addString(action);
+    row.addUInt32(lowGuid);
+    row.addUInt32(sess->GetAccountId());
+    row.addString(charName);
+    row.addString(sess->GetRemoteAddress());
+    row.addTime(time(nullptr));
+    m_logsWriter->Insert("INSERT INTO `logs_characters` (`type`, `guid`, `account`, `name`, `ip`, `time`) VALUES ", row);
 }
 
 void World::LogChat(WorldSession* sess, char const* type, std::string const& msg, PlayerPointer target, uint32 chanId, char const* chanStr)
@@ -2917,16 +2953,15 @@ void World::LogChat(WorldSession* sess, char const* type, std::string const& msg
 
     if (!LogsDatabase || !sWorld.getConfig(CONFIG_BOOL_LOGSDB_CHAT))
         return;
-    static SqlStatementID insLogChat;
-    SqlStatement logStmt = LogsDatabase.CreateStatement(insLogChat,
-            "INSERT INTO `logs_chat` SET `type`=?, `guid`=?, `target`=?, `channelId`=?, `channelName`=?, `message`=?");
-    logStmt.addString(type);
-    logStmt.addUInt32(plr->GetObjectGuid().GetCounter());
-    logStmt.addUInt32(target ? target->GetObjectGuid().GetCounter() : 0);
-    logStmt.addUInt32(chanId);
-    logStmt.addString(chanStr ? chanStr : "");
-    logStmt.addString(msg);
-    logStmt.Execute();
+    SqlBatchRow row(LogsDatabase);
+    row.addString(type);
+    row.addUInt32(plr->GetObjectGuid().GetCounter());
+    row.addUInt32(target ? target->GetObjectGuid().GetCounter() : 0);
+    row.addUInt32(chanId);
+    row.addString(chanStr ? chanStr : "");
+    row.addString(msg);
+    row.addTime(time(nullptr));
+    m_logsWriter->Insert("INSERT INTO `logs_chat` (`type`, `guid`, `target`, `channelId`, `channelName`, `message`, `time`) VALUES ", row);
 }
 
 void World::LogTransaction(PlayerTransactionData const& data)
@@ -2934,16 +2969,13 @@ void World::LogTransaction(PlayerTransactionData const& data)
     if (!LogsDatabase || !sWorld.getConfig(CONFIG_BOOL_LOGSDB_TRANSACTIONS))
         return;
 
-    static SqlStatementID insLogTransaction;
-    SqlStatement logStmt = LogsDatabase.CreateStatement(insLogTransaction,
-        "INSERT INTO `logs_transactions` SET `type`=?, `guid1`=?, `money1`=?, `spell1`=?, `items1`=?, "
-        "`guid2`=?, `money2`=?, `spell2`=?, `items2`=?");
-    logStmt.addString(data.type);
+    SqlBatchRow row(LogsDatabase);
+    row.addString(data.type);
     for (const auto& part : data.parts)
     {
-        logStmt.addUInt32(part.lowGuid);
-        logStmt.addUInt32(part.money);
-        logStmt.addUInt32(part.spell);
+        row.addUInt32(part.lowGuid);
+        row.addUInt32(part.money);
+        row.addUInt32(part.spell);
         std::stringstream items;
         for (int i = 0; i < TransactionPart::MAX_TRANSACTION_ITEMS; ++i)
         {
@@ -2954,9 +2986,10 @@ void World::LogTransaction(PlayerTransactionData const& data)
                 items << uint32(part.itemsEntries[i]) << ":" << uint32(part.itemsCount[i]) << ":" << part.itemsGuid[i];
             }
         }
-        logStmt.addString(items.str());
+        row.addString(items.str());
     }
-    logStmt.Execute();
+    row.addTime(time(nullptr));
+    m_logsWriter->Insert("INSERT INTO `logs_transactions` (`type`, `guid1`, `money1`, `spell1`, `items1`, `guid2`, `money2`, `spell2`, `items2`, `time`) VALUES ", row);
 }
 
 bool World::CanSkipQueue(WorldSession const* sess)
@@ -33,6 +33,7 @@
 #include "ObjectGuid.h"
 #include "Chat/AbstractPlayer.h"
 #include "WorldPacket.h"
+#include "LatencySamples.h"
 
 #include <map>
 #include <set>
@@ -49,6 +50,7 @@ class SqlResultQueue;
 class QueryResult;
 class World;
 class MovementBroadcaster;
+class SqlBatchWriter;
 
 World& GetSWorld();
 
@@ -91,17 +93,26 @@ enum WorldTimers
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_THRESHOLD,
     CONFIG_UINT32_LOGIN_QUEUE_GRACE_PERIOD_SECS,
     CONFIG_UINT32_CHARACTER_SCREEN_MAX_IDLE_TIME,
     CONFIG_UINT32_PLAYER_HARD_LIMIT,
     CONFIG_UINT32_ANTIFLOOD_SANCTION,
     CONFIG_UINT32_PACKET_BCAST_THREADS,
     CONFIG_UINT32_PACKET_BCAST_FREQUENCY,
+    CONFIG_UINT32_PBCAST_LOD_FAR_HEARTBEAT_INTERVAL,
+    CONFIG_UINT32_LOGSDB_BATCH_MAX_ROWS,
+    CONFIG_UINT32_LOGSDB_BATCH_MAX_BYTES,
+    CONFIG_UINT32_LOGSDB_BATCH_MAX_DELAY,
+    CONFIG_UINT32_LOGSDB_BATCH_MAX_DB_QUEUE,
+    CONFIG_UINT32_SESSION_RECV_QUEUE_SIZE,
     CONFIG_UINT32_MAILSPAM_EXPIRE_SECS,
     CONFIG_UINT32_MAILSPAM_MAX_MAILS,
     CONFIG_UINT32_MAILSPAM_LEVEL,
     CONFIG_UINT32_MAILSPAM_MONEY,
     CONFIG_UINT32_EMPTY_MAPS_UPDATE_TIME,
+    CONFIG_UINT32_MAPUPDATE_ADAPTIVE_MAX_INTERVAL,
+    CONFIG_UINT32_MAPUPDATE_ADAPTIVE_DENSE_PLAYERS,
     CONFIG_UINT32_COD_FORCE_TAG_MAX_LEVEL,
     CONFIG_UINT32_PUB_CHANS_MUTE_VANISH_LEVEL,
     CONFIG_UINT32_GMTICKETS_ADMIN_SECURITY,
@@ -109,7 +120,6 @@ enum eConfigUInt32Values
     CONFIG_UINT32_BATTLEGROUND_QUEUES_COUNT,
     CONFIG_UINT32_CORPSES_UPDATE_MINUTES,
     CONFIG_UINT32_BONES_EXPIRE_MINUTES,
-    CONFIG_UINT32_ASYNC_TASKS_THREADS_COUNT,
     CONFIG_UINT32_AV_MIN_PLAYERS_IN_QUEUE,
     CONFIG_UINT32_AV_INITIAL_MAX_PLAYERS,
     CONFIG_UINT32_INACTIVE_PLAYERS_SKIP_UPDATES,
@@ -136,7 +146,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_DYN_RESPAWN_AFFECT_LEVEL_BELOW,
     CONFIG_UINT32_MTCELLS_THREADS,
     CONFIG_UINT32_MTCELLS_SAFEDISTANCE,
-    CONFIG_UINT32_MAPUPDATE_INSTANCED_UPDATE_THREADS,
+    CONFIG_UINT32_MAPUPDATE_SCHEDULER_THREADS,
+    CONFIG_UINT32_STARTUP_LOADER_THREADS,
     CONFIG_UINT32_MAPUPDATE_UPDATE_PACKETS_DIFF,
     CONFIG_UINT32_MAPUPDATE_UPDATE_PLAYERS_DIFF,
     CONFIG_UINT32_MAPUPDATE_UPDATE_CELLS_DIFF,
@@ -347,6 +358,9 @@ enum
     ANTICRASH_OPTION_FLAGS_THROW_SIGSEGV= (ANTICRASH_OPTION_CRASH_INSTANCES|ANTICRASH_OPTION_CRASH_CONTINENTS),
 };
 
+// Eastern Kingdoms and Kalimdor
+#define MAX_CONTINENT_REGION_MAPS 2
+
 /// Configuration elements
 enum eConfigInt32Values
 {
@@ -433,6 +447,7 @@ enum eConfigFloatValues
     CONFIG_FLOAT_RATE_XP_PERSONAL_MAX,
     CONFIG_FLOAT_AC_MOVEMENT_CHEAT_TELEPORT_DISTANCE,
     CONFIG_FLOAT_AC_MOVEMENT_CHEAT_WALL_CLIMB_ANGLE,
+    CONFIG_FLOAT_PBCAST_LOD_NEAR_DISTANCE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -453,6 +468,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_LOGSDB_CHARACTERS,
     CONFIG_BOOL_LOGSDB_TRANSACTIONS,
     CONFIG_BOOL_LOGSDB_BATTLEGROUNDS,
+    CONFIG_BOOL_PERFLOG_MAP_TICK_INTERVAL,
     CONFIG_BOOL_SMARTLOG_DEATH,
     CONFIG_BOOL_SMARTLOG_LONGCOMBAT,
     CONFIG_BOOL_SMARTLOG_SCRIPTINFO,
@@ -690,7 +706,7 @@ struct CliCommandHolder
     ~CliCommandHolder() { delete[] m_command; }
 };
 
-class ThreadPool;
+class TaskScheduler;
 
 /// The World
 class World
@@ -832,6 +848,8 @@ class World
 
         // for max speed access
         static float GetMaxVisibleDistanceOnContinents()    { return m_MaxVisibleDistanceOnContinents; }
+        // World X coordinates splitting a continent into independently updated regions, empty for the other maps
+        std::vector<float> const& GetContinentRegionBounds(uint32 mapId) const;
         static float GetMaxVisibleDistanceInInstances()     { return m_MaxVisibleDistanceInInstances;  }
         static float GetMaxVisibleDistanceInBG()            { return m_MaxVisibleDistanceInBG;         }
 
@@ -856,6 +874,8 @@ class World
 
         // Nostalrius
         MovementBroadcaster* GetBroadcaster() { return m_broadcaster.get(); }
+        // Workers shared by the maps updates and the async tasks
+        TaskScheduler* GetUpdateScheduler() { return m_updateScheduler.get(); }
         float GetTimeRate() const { return m_timeRate; }
         void SetTimeRate(float rate) { m_timeRate = rate; }
         float m_timeRate;
@@ -881,6 +901,11 @@ class World
         void LogCharacter(WorldSession* sess, uint32 lowGuid, std::string const& charName, char const* action);
         void LogChat(WorldSession* sess, char const* type, std::string const& msg, PlayerPointer target = nullptr, uint32 chanId = 0, char const* chanStr = nullptr);
         void LogTransaction(PlayerTransactionData const& data);
+        // Rows of the logs database tables, written in batches
+        SqlBatchWriter& GetLogsWriter() { return *m_logsWriter; }
+        // Milliseconds from the login request to the character loaded, and to the end of the login queries
+        LatencySamples& GetLoginLatency() { return m_loginLatency; }
+        LatencySamples& GetLoginQueriesLatency() { return m_loginQueriesLatency; }
         void Shutdown();
         void AddSessionToSessionsMap(WorldSession* sess);
 
@@ -973,6 +998,7 @@ class World
         std::string m_dataPath;
         std::string m_honorPath;
         std::string m_wardenModuleDirectory;
+        std::vector<float> m_continentRegionBounds[MAX_CONTINENT_REGION_MAPS];
 
         // for max speed access
         static float m_MaxVisibleDistanceOnContinents;
@@ -1006,7 +1032,11 @@ class World
         // Packet broadcaster
         std::unique_ptr<MovementBroadcaster> m_broadcaster;
 
-        std::unique_ptr<ThreadPool> m_updateThreads;
+        std::unique_ptr<SqlBatchWriter> m_logsWriter;
+        LatencySamples m_loginLatency;
+        LatencySamples m_loginQueriesLatency;
+
+        std::unique_ptr<TaskScheduler> m_updateScheduler;
         
         static uint32 m_currentMSTime;
         static TimePoint m_currentTime;
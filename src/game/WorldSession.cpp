@@ -83,6 +83,12 @@ WorldSession::WorldSession(uint32 id, WorldSocket *sock, AccountTypes sec, time_
     }
     else
         m_address = "<BOT>";
+
+    for (uint32 i = 0; i < PACKET_PROCESS_MAX_TYPE; ++i)
+    {
+        m_recvQueue[i].setCapacity(sWorld.getConfig(CONFIG_UINT32_SESSION_RECV_QUEUE_SIZE));
+        m_recvQueueOverflows[i] = 0;
+    }
 }
 
 /// WorldSession destructor
@@ -101,10 +107,8 @@ WorldSession::~WorldSession()
     }
 
     ///- empty incoming packet queue
-    WorldPacket* packet = nullptr;
-    for (auto& i : m_recvQueue)
-        while (i.next(packet))
-            delete packet;
+    for (uint32 i = 0; i < PACKET_PROCESS_MAX_TYPE; ++i)
+        ClearIncomingPacketsByType(PacketProcessing(i));
 
     delete m_warden;
     delete m_cheatData;
@@ -214,7 +218,7 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 }
 
 /// Add an incoming packet to the queue
-void WorldSession::QueuePacket(WorldPacket* newPacket)
+bool WorldSession::QueuePacket(WorldPacket* newPacket)
 {
     if (_player && IsMovementOpcode(newPacket->GetOpcode()))
         GetCheatData()->LogMovementPacket(true, *newPacket);
@@ -225,11 +229,20 @@ void WorldSession::QueuePacket(WorldPacket* newPacket)
         sLog.outError("SESSION: opcode %s (0x%.4X) will be skipped",
                       LookupOpcodeName(newPacket->GetOpcode()),
                       newPacket->GetOpcode());
-        return;
+        return true;
     }
 
     uint32 processing = opHandle.packetProcessing;
-    m_recvQueue[processing].add(newPacket);
+    if (!m_recvQueue[processing].add(newPacket))
+    {
+        // Client sends faster than we process: the caller disconnects it
+        ++m_recvQueueOverflows[processing];
+        sLog.outError("SESSION: receive queue %u full for account %u / IP %s (%s), flooding",
+                      processing, GetAccountId(), GetRemoteAddress().c_str(), LookupOpcodeName(newPacket->GetOpcode()));
+        delete newPacket;
+        return false;
+    }
+    return true;
 }
 
 /// Logging helper for unexpected opcodes
@@ -451,9 +464,11 @@ void WorldSession::ProcessPackets(PacketFilter& updater)
 void WorldSession::ClearIncomingPacketsByType(PacketProcessing type)
 {
     ASSERT(type < PACKET_PROCESS_MAX_TYPE);
-    WorldPacket* data = nullptr;
-    while (m_recvQueue[type].next(data))
-        delete data;
+    WorldPacket* data[64];
+    PacketFilter all(this);
+    while (size_t count = m_recvQueue[type].nextBatch(data, 64, all))
+        for (size_t i = 0; i < count; ++i)
+            delete data[i];
 }
 
 void WorldSession::SetDisconnectedSession()
@@ -29,6 +29,7 @@
 #include "Item.h"
 #include "GossipDef.h"
 #include "Chat/AbstractPlayer.h"
+#include "MPSCQueue.h"
 
 struct ItemPrototype;
 struct AuctionEntry;
@@ -347,12 +348,15 @@ class WorldSession
         bool m_ah_list_recvd;
 
         bool Update(PacketFilter& updater);
-        void QueuePacket(WorldPacket* new_packet);
+        bool QueuePacket(WorldPacket* new_packet);          // false: the queue is full and the packet deleted, the client floods
         bool CanProcessPackets() const; // Returns true iif we can process packets (ie logged in Player, not a bot, etc ...
         void ProcessPackets(PacketFilter& updater);
         bool AllowPacket(uint16 opcode);
         void ClearIncomingPacketsByType(PacketProcessing type);
         inline bool HasRecentPacket(PacketProcessing type) const { return m_receivedPacketType[type]; }
+        size_t GetRecvQueueDepth(PacketProcessing type) const { return m_recvQueue[type].size(); }
+        size_t GetRecvQueueCapacity(PacketProcessing type) const { return m_recvQueue[type].capacity(); }
+        uint32 GetRecvQueueOverflows(PacketProcessing type) const { return m_recvQueueOverflows[type]; }
 
         void SendPacket(WorldPacket const* packet);
         void SendNotification(char const* format, ...) ATTR_PRINTF(2, 3);
@@ -801,7 +805,9 @@ class WorldSession
 
         WorldSocket* m_socket;
         std::string m_address;
-        LockedQueue<WorldPacket*, std::mutex> m_recvQueue[PACKET_PROCESS_MAX_TYPE];
+        // Filled by the network threads, drained by the world and map threads
+        BoundedMPSCQueue<WorldPacket*> m_recvQueue[PACKET_PROCESS_MAX_TYPE];
+        std::atomic<uint32> m_recvQueueOverflows[PACKET_PROCESS_MAX_TYPE];
         bool m_receivedPacketType[PACKET_PROCESS_MAX_TYPE];
         uint32 m_floodPacketsCount[FLOOD_MAX_OPCODES_TYPE];
         bool m_connected;
@@ -322,7 +322,12 @@ int OfflineChatSocket::handle_input(ACE_HANDLE)
                     sendf("err_packet\n");
                     return 0;
             }
-            player->GetSession()->QueuePacket(data);
+            if (!player->GetSession()->QueuePacket(data))
+            {
+                DEBUG_OUT_CHAT(">> Queue full.");
+                sendf("err_queue_full\n");
+                return 0;
+            }
             DEBUG_OUT_CHAT(">> Queue packet.");
         }
     }
@@ -46,6 +46,7 @@
 #include "Util.h"
 #include "MaNGOSsoap.h"
 #include "MassMailMgr.h"
+#include "Database/SqlBatchWriter.h"
 #include "DBCStores.h"
 #include "migrations_list.h"
 
@@ -349,6 +350,7 @@ int Master::Run()
     sWorldSocketMgr->SetThreads(sConfig.GetIntDefault("Network.Threads", 1) + 1);
     sWorldSocketMgr->SetInterval(sConfig.GetIntDefault("Network.Interval", 10));
     sWorldSocketMgr->SetTcpNodelay(sConfig.GetBoolDefault("Network.TcpNodelay", true));
+    sWorldSocketMgr->SetThreadAffinity(sConfig.GetIntDefault("Network.ThreadAffinity", -1));
 
     if (sWorldSocketMgr->StartNetwork(wsport, bind_ip) == -1)
     {
@@ -403,6 +405,9 @@ int Master::Run()
     sLog.outString("Sending queued mail...");
     sMassMailMgr.Update(true);
 
+    // write the log rows still waiting in a batch
+    sWorld.GetLogsWriter().Flush();
+
     ///- Wait for DB delay threads to end
     sLog.outString("Closing database connections...");
     CharacterDatabase.StopServer();
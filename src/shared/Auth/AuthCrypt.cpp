@@ -36,19 +36,29 @@ void AuthCrypt::Init()
     _initialized = true;
 }
 
+// The state is copied to locals: data is uint8* and may alias the members,
+// which would force a reload of the key and the indexes after every byte.
 void AuthCrypt::DecryptRecv(uint8* data, size_t len)
 {
     if (!_initialized) { return; }
     if (len < CRYPTED_RECV_LEN) { return; }
 
+    uint8 const* key = _key.data();
+    size_t const keySize = _key.size();
+    uint8 i = _recv_i, j = _recv_j;
+
     for (size_t t = 0; t < CRYPTED_RECV_LEN; t++)
     {
-        _recv_i %= _key.size();
-        uint8 x = (data[t] - _recv_j) ^ _key[_recv_i];
-        ++_recv_i;
-        _recv_j = data[t];
+        if (i >= keySize)
+            i = 0;
+        uint8 x = (data[t] - j) ^ key[i];
+        ++i;
+        j = data[t];
         data[t] = x;
     }
+
+    _recv_i = i;
+    _recv_j = j;
 }
 
 void AuthCrypt::EncryptSend(uint8* data, size_t len)
@@ -56,13 +66,21 @@ void AuthCrypt::EncryptSend(uint8* data, size_t len)
     if (!_initialized) { return; }
     if (len < CRYPTED_SEND_LEN) { return; }
 
+    uint8 const* key = _key.data();
+    size_t const keySize = _key.size();
+    uint8 i = _send_i, j = _send_j;
+
     for (size_t t = 0; t < CRYPTED_SEND_LEN; t++)
     {
-        _send_i %= _key.size();
-        uint8 x = (data[t] ^ _key[_send_i]) + _send_j;
-        ++_send_i;
-        data[t] = _send_j = x;
+        if (i >= keySize)
+            i = 0;
+        uint8 x = (data[t] ^ key[i]) + j;
+        ++i;
+        data[t] = j = x;
     }
+
+    _send_i = i;
+    _send_j = j;
 }
 
 void AuthCrypt::SetKey(std::vector<uint8> const& key)
@@ -47,7 +47,7 @@ class AuthCrypt
         void DecryptRecv(uint8*, size_t);
         void EncryptSend(uint8*, size_t);
 
-        bool IsInitialized() { return _initialized; }
+        bool IsInitialized() const { return _initialized; }
 
         static void GenerateKey(uint8*, BigNumber*);
 
@@ -70,6 +70,8 @@ class NoCrypt
 
         void DecryptRecv(uint8*, size_t) {}
         void EncryptSend(uint8*, size_t) {}
+
+        bool IsInitialized() const { return false; }
 };
 
 #endif
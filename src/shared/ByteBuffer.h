@@ -25,6 +25,7 @@
 #include "Common.h"
 #include "Log.h"
 #include "Utilities/ByteConverter.h"
+#include "PacketBufferPool.h"
 
 class ByteBufferException
 {
@@ -538,7 +539,8 @@ class ByteBuffer
 
     protected:
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        // Storage comes from size-classed per thread pools, see PacketBufferPool
+        std::vector<uint8, PacketBufferAllocator<uint8>> _storage;
 };
 
 template <typename T>
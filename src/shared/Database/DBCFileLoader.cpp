@@ -28,95 +28,109 @@
 DBCFileLoader::DBCFileLoader()
 {
     data = nullptr;
+    stringTable = nullptr;
     fieldsOffset = nullptr;
 }
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
+    Unload();
 
-    uint32 header;
-    if(data)
-    {
-        delete [] data;
-        data=nullptr;
-    }
-
-    FILE* f=fopen(filename,"rb");
-    if(!f)return false;
+    if (!mappedFile.Open(filename))
+        return false;
 
-    if(fread(&header,4,1,f)!=1)                             // Number of records
+    if (!ReadHeader(mappedFile.GetData()))
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(header);
-    if(header!=0x43424457)
-    {
-        fclose(f);
-        return false;                                       //'WDBC'
-    }
+    data = mappedFile.GetData() + HEADER_SIZE;
+    stringTable = data + recordSize * recordCount;
 
-    if(fread(&recordCount,4,1,f)!=1)                        // Number of records
+    fieldsOffset = new uint32[fieldCount];
+    fieldsOffset[0] = 0;
+    for(uint32 i = 1; i < fieldCount; i++)
     {
-        fclose(f);
-        return false;
+        fieldsOffset[i] = fieldsOffset[i - 1];
+        if (fmt[i - 1] == 'b' || fmt[i - 1] == 'X')         // byte fields
+            fieldsOffset[i] += 1;
+        else                                                // 4 byte fields (int32/float/strings)
+            fieldsOffset[i] += 4;
     }
 
-    EndianConvert(recordCount);
+    return true;
+}
 
-    if(fread(&fieldCount,4,1,f)!=1)                         // Number of fields
-    {
-        fclose(f);
+bool DBCFileLoader::ReadHeader(unsigned char const* header)
+{
+    if (mappedFile.GetSize() < HEADER_SIZE)
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    uint32 fields[HEADER_SIZE / 4];
+    memcpy(fields, header, HEADER_SIZE);
+    for (uint32& field : fields)
+        EndianConvert(field);
 
-    if(fread(&recordSize,4,1,f)!=1)                         // Size of a record
-    {
-        fclose(f);
+    if (fields[0] != 0x43424457)                            //'WDBC'
         return false;
-    }
 
-    EndianConvert(recordSize);
+    recordCount = fields[1];
+    fieldCount = fields[2];
+    recordSize = fields[3];
+    stringSize = fields[4];
+    return fieldCount != 0 && HEADER_SIZE + uint64(recordSize) * recordCount + stringSize <= mappedFile.GetSize();
+}
 
-    if(fread(&stringSize,4,1,f)!=1)                         // String size
-    {
-        fclose(f);
-        return false;
-    }
+void DBCFileLoader::Unload()
+{
+    mappedFile.Close();
 
-    EndianConvert(stringSize);
+    delete [] fieldsOffset;
+    fieldsOffset = nullptr;
+    data = nullptr;
+    stringTable = nullptr;
+}
 
-    fieldsOffset = new uint32[fieldCount];
-    fieldsOffset[0] = 0;
-    for(uint32 i = 1; i < fieldCount; i++)
-    {
-        fieldsOffset[i] = fieldsOffset[i - 1];
-        if (fmt[i - 1] == 'b' || fmt[i - 1] == 'X')         // byte fields
-            fieldsOffset[i] += 1;
-        else                                                // 4 byte fields (int32/float/strings)
-            fieldsOffset[i] += 4;
-    }
+DBCFileLoader::~DBCFileLoader()
+{
+    Unload();
+}
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
-    stringTable = data + recordSize*recordCount;
+bool DBCFileLoader::IsFileLayout(char const* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_LITTLEENDIAN
+    if (!mappedFile.IsMapped() || strlen(format) != fieldCount || GetFormatRecordSize(format) != recordSize)
+        return false;
 
-    if(fread(data,recordSize*recordCount+stringSize,1,f)!=1)
+    bool hasWideFields = false;
+    for (uint32 x = 0; format[x]; ++x)
     {
-        fclose(f);
-        return false;
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+                hasWideFields = true;
+                break;
+            case FT_BYTE:
+                break;
+            default:                                        // strings, skipped fields
+                return false;
+        }
     }
 
-    fclose(f);
-    return true;
+    // The records follow the 20 bytes header of a page aligned mapping
+    return !hasWideFields || recordSize % 4 == 0;
+#else
+    return false;
+#endif
 }
 
-DBCFileLoader::~DBCFileLoader()
+void DBCFileLoader::ReleaseRecordPages()
 {
-    delete [] data;
-    delete [] fieldsOffset;
+    // Only the pages holding nothing but records, the string table stays in use
+    mappedFile.ReleasePages(stringTable - mappedFile.GetData());
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -212,6 +226,14 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    if (IsFileLayout(format))
+    {
+        // The records of the mapping are used in place
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = const_cast<char*>(reinterpret_cast<char const*>(data + y * recordSize));
+        return const_cast<char*>(reinterpret_cast<char const*>(data));
+    }
+
     char* dataTable= new char[recordCount*recordsize];
 
     uint32 offset=0;
@@ -268,8 +290,13 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
     if(strlen(format)!=fieldCount)
         return nullptr;
 
-    char* stringPool= new char[stringSize];
-    memcpy(stringPool,stringTable,stringSize);
+    // The strings of a mapped file are used in place, never written
+    char* stringPool = const_cast<char*>(reinterpret_cast<char const*>(stringTable));
+    if (!mappedFile.IsMapped())
+    {
+        stringPool = new char[stringSize];
+        memcpy(stringPool,stringTable,stringSize);
+    }
 
     uint32 offset=0;
 
@@ -315,5 +342,5 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return mappedFile.IsMapped() ? nullptr : stringPool;
 }
@@ -23,6 +23,7 @@
 #define DBC_FILE_LOADER_H
 #include "Platform/Define.h"
 #include "Utilities/ByteConverter.h"
+#include "MappedFile.h"
 #include <cassert>
 
 enum FieldFormat
@@ -55,21 +56,21 @@ class DBCFileLoader
                 float getFloat(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    float val = *reinterpret_cast<float*>(offset+file.GetOffset(field));
+                    float val = *reinterpret_cast<float const*>(offset+file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
                 uint32 getUInt(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    uint32 val = *reinterpret_cast<uint32*>(offset+file.GetOffset(field));
+                    uint32 val = *reinterpret_cast<uint32 const*>(offset+file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
                 uint8 getUInt8(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    return *reinterpret_cast<uint8*>(offset+file.GetOffset(field));
+                    return *reinterpret_cast<uint8 const*>(offset+file.GetOffset(field));
                 }
 
                 char const* getString(size_t field) const
@@ -77,12 +78,12 @@ class DBCFileLoader
                     assert(field < file.fieldCount);
                     size_t stringOffset = getUInt(field);
                     assert(stringOffset < file.stringSize);
-                    return reinterpret_cast<char*>(file.stringTable + stringOffset);
+                    return reinterpret_cast<char const*>(file.stringTable + stringOffset);
                 }
 
             private:
-                Record(DBCFileLoader& file_, unsigned char* offset_): offset(offset_), file(file_) {}
-                unsigned char* offset;
+                Record(DBCFileLoader& file_, unsigned char const* offset_): offset(offset_), file(file_) {}
+                unsigned char const* offset;
                 DBCFileLoader& file;
 
                 friend class DBCFileLoader;
@@ -97,17 +98,30 @@ class DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() {return (data!=nullptr);}
+        // The file is mapped rather than read, the mapping lives as long as the loader
+        bool IsMapped() const { return mappedFile.IsMapped(); }
+        // The records of the mapping can be used as the records of fmt without conversion
+        bool IsFileLayout(char const* fmt) const;
+        // Returns the records of the mapping when IsFileLayout, not to be deleted
         char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
+        // Returns the copied string pool, nullptr when the strings of the mapping are used
         char* AutoProduceStrings(char const* fmt, char* dataTable);
+        // Lets the system drop the record pages of a mapping when only its strings are still used
+        void ReleaseRecordPages();
         static uint32 GetFormatRecordSize(char const* format, int32* index_pos = nullptr);
     private:
+        static size_t const HEADER_SIZE = 20;
+
+        bool ReadHeader(unsigned char const* header);
+        void Unload();
 
         uint32 recordSize;
         uint32 recordCount;
         uint32 fieldCount;
         uint32 stringSize;
         uint32* fieldsOffset;
-        unsigned char* data;
-        unsigned char* stringTable;
+        MappedFile mappedFile;
+        unsigned char const* data;
+        unsigned char const* stringTable;
 };
 #endif
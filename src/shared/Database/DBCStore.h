@@ -23,13 +23,17 @@
 #define DBCSTORE_H
 
 #include "DBCFileLoader.h"
+#include <cstring>
+#include <list>
+#include <memory>
 
 template<class T>
 class DBCStorage
 {
     typedef std::list<char*> StringPoolList;
+    typedef std::list<std::unique_ptr<DBCFileLoader>> FileList;
     public:
-        explicit DBCStorage(char const* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr) { }
+        explicit DBCStorage(char const* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr), m_dataInPlace(false) { }
         ~DBCStorage() { Clear(); }
 
         T const* LookupEntry(uint32 id) const { return (id>=nCount)?nullptr:indexTable[id]; }
@@ -38,21 +42,27 @@ class DBCStorage
         uint32  GetNumRows() const { return nCount; }
         char const* GetFormat() const { return fmt; }
         uint32 GetFieldCount() const { return fieldCount; }
+        // The records are those of the mapped file, not a copy
+        bool IsInPlace() const { return m_dataInPlace; }
 
         bool Load(char const* fn)
         {
-            DBCFileLoader dbc;
+            std::unique_ptr<DBCFileLoader> dbc(new DBCFileLoader);
             // Check if load was sucessful, only then continue
-            if(!dbc.Load(fn, fmt))
+            if(!dbc->Load(fn, fmt))
                 return false;
 
-            fieldCount = dbc.GetCols();
+            fieldCount = dbc->GetCols();
 
             // load raw non-string data
-            m_dataTable = (T*)dbc.AutoProduceData(fmt,nCount,(char**&)indexTable);
+            m_dataInPlace = dbc->IsFileLayout(fmt);
+            m_dataTable = (T*)dbc->AutoProduceData(fmt,nCount,(char**&)indexTable);
 
             // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable));
+            if (char* stringPool = dbc->AutoProduceStrings(fmt,(char*)m_dataTable))
+                m_stringPoolList.push_back(stringPool);
+
+            KeepMapping(std::move(dbc), m_dataInPlace);
 
             // error in dbc file at loading if nullptr
             return indexTable!=nullptr;
@@ -64,13 +74,16 @@ class DBCStorage
             if(!indexTable)
                 return false;
 
-            DBCFileLoader dbc;
+            std::unique_ptr<DBCFileLoader> dbc(new DBCFileLoader);
             // Check if load was successful, only then continue
-            if(!dbc.Load(fn, fmt))
+            if(!dbc->Load(fn, fmt))
                 return false;
 
             // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable));
+            if (char* stringPool = dbc->AutoProduceStrings(fmt,(char*)m_dataTable))
+                m_stringPoolList.push_back(stringPool);
+
+            KeepMapping(std::move(dbc), false);
 
             return true;
         }
@@ -82,26 +95,42 @@ class DBCStorage
 
             delete[] ((char*)indexTable);
             indexTable = nullptr;
-            delete[] ((char*)m_dataTable);
+            if (!m_dataInPlace)
+                delete[] ((char*)m_dataTable);
             m_dataTable = nullptr;
+            m_dataInPlace = false;
 
             while(!m_stringPoolList.empty())
             {
                 delete[] m_stringPoolList.front();
                 m_stringPoolList.pop_front();
             }
+            m_files.clear();
             nCount = 0;
         }
 
         void EraseEntry(uint32 id) { indexTable[id] = nullptr; }
 
     private:
+        // The records or the strings used in place point into the mapping of the file
+        void KeepMapping(std::unique_ptr<DBCFileLoader> dbc, bool recordsInPlace)
+        {
+            if (!dbc->IsMapped() || (!recordsInPlace && !strchr(fmt, FT_STRING)))
+                return;
+
+            if (!recordsInPlace)
+                dbc->ReleaseRecordPages();
+            m_files.push_back(std::move(dbc));
+        }
+
         uint32 nCount;
         uint32 fieldCount;
         char const* fmt;
         T** indexTable;
         T* m_dataTable;
+        bool m_dataInPlace;
         StringPoolList m_stringPoolList;
+        FileList m_files;
 };
 
 #endif
@@ -134,6 +134,19 @@ bool SqlConnection::ExecuteStmt(int nIndex, SqlStmtParameters const& id)
     return false;
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, SqlStmtParameters const& id)
+{
+    if(nIndex == -1)
+        return nullptr;
+
+    if (SqlPreparedStatement* pStmt = GetStmt(nIndex))
+    {
+        pStmt->bind(id);
+        return pStmt->query();
+    }
+    return nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
@@ -183,8 +196,6 @@ bool Database::Initialize(char const* infoString, int nConns /*= 1*/, int nWorke
     if(!m_pAsyncConn->Initialize(infoString))
         return false;
 
-    m_numAsyncWorkers = nWorkers;
-
     for (int i = 0; i < nWorkers; ++i)
         if (!InitDelayThread(infoString))
             return false;
@@ -227,29 +238,34 @@ bool Database::InitDelayThread(std::string const& infoString)
         return false;
 
     std::shared_ptr<SqlDelayThread> tbody = std::make_shared<SqlDelayThread>(this, threadConnection);
+    std::unique_lock<std::mutex> lock(m_workersMutex);
     m_threadsBodies.emplace_back(tbody);
     m_delayThreads.emplace_back([tbody](){
         tbody->run();
     });
+    m_numAsyncWorkers = m_threadsBodies.size();
 
     return true;
 }
 
 void Database::HaltDelayThread()
 {
-    if (m_delayThreads.empty() || m_threadsBodies.empty())
-        return;
-
-    for (uint32 i = 0; i < m_numAsyncWorkers; ++i)
-        m_threadsBodies[i]->Stop();
-
-    for (uint32 i = 0; i < m_numAsyncWorkers; ++i)
-        m_delayThreads[i].join();
+    std::vector<std::shared_ptr<SqlDelayThread>> threadsBodies;
+    std::vector<std::thread> delayThreads;
+    {
+        // No more wake up of the workers from now
+        std::unique_lock<std::mutex> lock(m_workersMutex);
+        m_numAsyncWorkers = 0;
+        threadsBodies.swap(m_threadsBodies);
+        delayThreads.swap(m_delayThreads);
+    }
 
-    m_threadsBodies.clear();
-    m_delayThreads.clear();
+    // Outside of the lock, the workers may still queue operations while they finish
+    for (auto& body : threadsBodies)
+        body->Stop();
 
-    m_numAsyncWorkers = 0;
+    for (auto& thread : delayThreads)
+        thread.join();
 }
 
 void Database::ThreadStart()
@@ -292,6 +308,22 @@ SqlConnection* Database::getQueryConnection()
     return m_pQueryConnections[nCount % m_nQueryConnPoolSize];
 }
 
+thread_local uint64 Database::s_threadFetchedRows = 0;
+
+QueryResult* Database::CountFetchedRows(QueryResult* result)
+{
+    if (result)
+        s_threadFetchedRows += result->GetRowCount();
+    return result;
+}
+
+QueryNamedResult* Database::CountFetchedRows(QueryNamedResult* result)
+{
+    if (result)
+        s_threadFetchedRows += result->GetRowCount();
+    return result;
+}
+
 void Database::Ping()
 {
     char const* sql = "SELECT 1";
@@ -480,6 +512,14 @@ uint32 Database::GetTransactionSerialId()
     return 0;
 }
 
+size_t Database::GetTransactionSize()
+{
+    if (SqlTransaction *trans = m_TransStorage->get())
+        return trans->Size();
+
+    return 0;
+}
+
 bool Database::CommitTransaction()
 {
     if (!m_pAsyncConn)
@@ -534,26 +574,68 @@ bool Database::RollbackTransaction()
     return true;
 }
 
-void Database::AddToSerialDelayQueue(SqlOperation* op)
+void Database::AddToDelayQueue(SqlOperation* op)
+{
+    m_delayQueue->add(op);
+
+    // Any worker can execute it, wake them up in turn
+    if (!m_numAsyncWorkers)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_workersMutex);
+    uint32 const numWorkers = m_numAsyncWorkers;
+    if (!numWorkers)
+        return;
+    m_threadsBodies[m_nDelayWakeUpCounter++ % numWorkers]->WakeUp();
+}
+
+std::vector<SqlDelayThread::Stats> Database::GetAsyncWorkersStats() const
+{
+    std::vector<SqlDelayThread::Stats> stats;
+    std::unique_lock<std::mutex> lock(m_workersMutex);
+    for (auto const& body : m_threadsBodies)
+        stats.push_back(body->GetStats());
+    return stats;
+}
+
+void Database::AddToSerialDelayQueue(int workerId, SqlOperation* op)
 {
-    if (op->GetSerialId() == 0 || m_numAsyncWorkers == 0)
+    std::unique_lock<std::mutex> lock(m_workersMutex);
+    if (workerId >= 0 && uint32(workerId) < m_threadsBodies.size())
     {
-        AddToDelayQueue(op);
+        m_threadsBodies[workerId]->addSerialOperation(op);
         return;
     }
+    lock.unlock();
+    AddToDelayQueue(op);
+}
 
-    // This is a very naive way of doing this. No load balancing.
-    // TODO: Load balance, must maintain mapping of serial ID so queries are
-    // executed sequentially, however
-    int worker = op->GetSerialId() % m_numAsyncWorkers;
-    m_threadsBodies[worker]->addSerialOperation(op);
+void Database::AddToSerialDelayQueue(SqlOperation* op)
+{
+    if (op->GetSerialId() != 0)
+    {
+        std::unique_lock<std::mutex> lock(m_workersMutex);
+        uint32 const numWorkers = m_numAsyncWorkers;
+        if (numWorkers)
+        {
+            // This is a very naive way of doing this. No load balancing.
+            // TODO: Load balance, must maintain mapping of serial ID so queries are
+            // executed sequentially, however
+            int worker = op->GetSerialId() % numWorkers;
+            m_threadsBodies[worker]->addSerialOperation(op);
+            return;
+        }
+    }
+
+    AddToDelayQueue(op);
 }
 
 bool Database::HasAsyncQuery()
 {
     bool hasQuery = !m_delayQueue->empty_unsafe();
 
-    for (uint32 i = 0; i < m_numAsyncWorkers && !hasQuery; ++i)
+    std::unique_lock<std::mutex> lock(m_workersMutex);
+    for (size_t i = 0; i < m_threadsBodies.size() && !hasQuery; ++i)
         hasQuery = m_threadsBodies[i]->HasAsyncQuery();
 
     return hasQuery;
@@ -650,6 +732,14 @@ bool Database::DirectExecuteStmt(SqlStatementID const& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt(SqlStatementID const& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+    std::unique_ptr<SqlStmtParameters> p(params);
+    SqlConnection::Lock _guard(getQueryConnection());
+    return CountFetchedRows(_guard->QueryStmt(id.ID(), *params));
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, char const* fmt)
 {
     int nId = -1;
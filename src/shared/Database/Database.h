@@ -55,6 +55,8 @@ class SqlConnection
         //public methods for making queries
         virtual QueryResult* Query(char const* sql) = 0;
         virtual QueryNamedResult* QueryNamed(char const* sql) = 0;
+        //numeric columns converted once for all the rows, for big results read field by field
+        virtual QueryResult* QueryTyped(char const* sql) { return Query(sql); }
 
         //public methods for making requests
         virtual bool Execute(char const* sql) = 0;
@@ -70,6 +72,7 @@ class SqlConnection
 
         //methods to work with prepared statements
         bool ExecuteStmt(int nIndex, SqlStmtParameters const& id);
+        QueryResult* QueryStmt(int nIndex, SqlStmtParameters const& id);
 
         //SqlConnection object lock
         class Lock
@@ -130,13 +133,19 @@ class Database
         inline QueryResult* Query(char const* sql)
         {
             SqlConnection::Lock guard(getQueryConnection());
-            return guard->Query(sql);
+            return CountFetchedRows(guard->Query(sql));
         }
 
         inline QueryNamedResult* QueryNamed(char const* sql)
         {
             SqlConnection::Lock guard(getQueryConnection());
-            return guard->QueryNamed(sql);
+            return CountFetchedRows(guard->QueryNamed(sql));
+        }
+
+        inline QueryResult* QueryTyped(char const* sql)
+        {
+            SqlConnection::Lock guard(getQueryConnection());
+            return CountFetchedRows(guard->QueryTyped(sql));
         }
 
         QueryResult* PQuery(char const* format,...) ATTR_PRINTF(2,3);
@@ -226,6 +235,8 @@ class Database
         bool BeginTransaction(uint32 serialId = 0);
         bool InTransaction();
         uint32 GetTransactionSerialId();
+        // number of statements queued in the transaction of the current thread
+        size_t GetTransactionSize();
         bool CommitTransaction();
         bool RollbackTransaction();
         //for sync transaction execution
@@ -261,20 +272,29 @@ class Database
         //you should call it explicitly after your server successfully started up
         //NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
-        inline void AddToDelayQueue(SqlOperation* op) { m_delayQueue->add(op); }
+        void AddToDelayQueue(SqlOperation* op);
         inline bool NextDelayedOperation(SqlOperation*& op) { return m_delayQueue->next(op); }
 
-        inline void AddToSerialDelayQueue(int workerId, SqlOperation* op) { m_threadsBodies[workerId]->addSerialOperation(op); }
+        void AddToSerialDelayQueue(int workerId, SqlOperation* op);
         bool NextSerialDelayedOperation(int workerId, SqlOperation*& op);
 
         bool HasAsyncQuery();
 
         void AddToSerialDelayQueue(SqlOperation* op);
 
+        // Operations waiting for any async worker
+        size_t GetDelayQueueSize() const { return m_delayQueue->size(); }
+        uint32 GetAsyncWorkersCount() const { return m_numAsyncWorkers; }
+        // Latency and serial queue of each async worker (one connection each)
+        std::vector<SqlDelayThread::Stats> GetAsyncWorkersStats() const;
+
         // Frees data, cancels scheduled queries, closes connection
         void StopServer();
+
+        // Rows returned by the sync queries of the current thread, all databases
+        static uint64 GetThreadFetchedRows() { return s_threadFetchedRows; }
     protected:
-        Database() : m_nQueryConnPoolSize(1), m_delayQueue(new SqlQueue()), m_pAsyncConn(nullptr),
+        Database() : m_nQueryConnPoolSize(1), m_delayQueue(new SqlQueue()), m_nDelayWakeUpCounter(0), m_pAsyncConn(nullptr),
                      m_pResultQueue(nullptr), m_numAsyncWorkers(0),
                      m_bAllowAsyncTransactions(false), m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
@@ -313,6 +333,10 @@ class Database
 
         //round-robin connection selection
         SqlConnection* getQueryConnection();
+
+        static QueryResult* CountFetchedRows(QueryResult* result);
+        static QueryNamedResult* CountFetchedRows(QueryNamedResult* result);
+        static thread_local uint64 s_threadFetchedRows;
         //for now return one single connection for async requests
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
 
@@ -321,6 +345,7 @@ class Database
         //query function for prepared statements
         bool ExecuteStmt(SqlStatementID const& id, SqlStmtParameters* params);
         bool DirectExecuteStmt(SqlStatementID const& id, SqlStmtParameters* params);
+        QueryResult* QueryStmt(SqlStatementID const& id, SqlStmtParameters* params);
 
         //connection helper counters
         int m_nQueryConnPoolSize;                               //current size of query connection pool
@@ -331,11 +356,13 @@ class Database
         SqlConnectionContainer m_pQueryConnections;
 
         SqlQueue* m_delayQueue;
+        std::atomic<uint32> m_nDelayWakeUpCounter;            //worker woken up for the next operation
 
         SqlConnection* m_pAsyncConn;
 
         SqlResultQueue*     m_pResultQueue;                  ///< Transaction queues from diff. threads
-        uint32              m_numAsyncWorkers;
+        std::atomic<uint32> m_numAsyncWorkers;               ///< 0 once the workers are halted
+        mutable std::mutex  m_workersMutex;                  ///< Guards m_threadsBodies, held to wake up or stop the workers
         std::vector<std::shared_ptr<SqlDelayThread>>    m_threadsBodies;                  ///< Pointer to delay sql executer (owned by m_delayThread)
         std::vector<std::thread> m_delayThreads;                   ///< Pointer to executer thread
 
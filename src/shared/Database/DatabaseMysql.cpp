@@ -252,6 +252,22 @@ QueryResult* MySQLConnection::Query(char const* sql)
     return queryResult;
 }
 
+QueryResult* MySQLConnection::QueryTyped(char const* sql)
+{
+    MYSQL_RES* result = nullptr;
+    MYSQL_FIELD* fields = nullptr;
+    uint64 rowCount = 0;
+    uint32 fieldCount = 0;
+
+    if(!_Query(sql,&result,&fields,&rowCount,&fieldCount))
+        return nullptr;
+
+    QueryResultMysqlTyped *queryResult = new QueryResultMysqlTyped(result, fields, rowCount, fieldCount);
+
+    queryResult->NextRow();
+    return queryResult;
+}
+
 QueryNamedResult* MySQLConnection::QueryNamed(char const* sql)
 {
     MYSQL_RES* result = nullptr;
@@ -502,6 +518,37 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResult* MySqlPreparedStatement::query()
+{
+    if(!isPrepared() || !isQuery())
+        return nullptr;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    if(mysql_stmt_execute(m_stmt) || mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outError("SQL: cannot execute '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return nullptr;
+    }
+
+    uint64 rowCount = mysql_stmt_num_rows(m_stmt);
+    QueryResultMysqlStmt* queryResult = rowCount ? new QueryResultMysqlStmt(m_stmt, m_pResultMetadata, rowCount, m_nColumns) : nullptr;
+    mysql_stmt_free_result(m_stmt);
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s,WorldTimer::getMSTime()), m_szFmt.c_str());
+
+    if(queryResult && !queryResult->IsValid())
+    {
+        delete queryResult;
+        return nullptr;
+    }
+
+    if(queryResult)
+        queryResult->NextRow();
+    return queryResult;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType(SqlStmtFieldData const& data, my_bool& bUnsigned)
 {
     bUnsigned = 0;
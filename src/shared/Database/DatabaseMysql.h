@@ -59,6 +59,9 @@ public:
     //execute DML statement
     bool execute() override;
 
+    //execute query, the rows are received with the binary protocol
+    QueryResult* query() override;
+
 protected:
     //bind parameters
     void addParam(int nIndex, SqlStmtFieldData const& data);
@@ -87,6 +90,7 @@ class MySQLConnection : public SqlConnection
 
         QueryResult* Query(char const* sql) override;
         QueryNamedResult* QueryNamed(char const* sql) override;
+        QueryResult* QueryTyped(char const* sql) override;
         bool Execute(char const* sql) override;
 
         unsigned long escape_string(char* to, char const* from, unsigned long length) override;
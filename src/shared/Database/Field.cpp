@@ -20,3 +20,26 @@
  */
 
 //#include "DatabaseEnv.h"
+#include "Field.h"
+
+#include <cfloat>
+
+void Field::FormatNumber() const
+{
+    switch (mStorage)
+    {
+        case STORAGE_INT64:  snprintf(mText, sizeof(mText), SI64FMTD, mNumber.i); break;
+        case STORAGE_UINT64: snprintf(mText, sizeof(mText), UI64FMTD, mNumber.u); break;
+        case STORAGE_FLOAT:
+            // shortest text giving the same float back, like the text protocol: 1.1, not 1.10000002384186
+            for (int precision = FLT_DIG; precision <= 9; ++precision)
+            {
+                snprintf(mText, sizeof(mText), "%.*g", precision, mNumber.d);
+                if (strtof(mText, nullptr) == static_cast<float>(mNumber.d))
+                    break;
+            }
+            break;
+        default:             snprintf(mText, sizeof(mText), "%.15g", mNumber.d); break;
+    }
+    mValue = mText;
+}
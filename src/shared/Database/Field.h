@@ -37,45 +37,125 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN) {}
-        Field(char const* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN), mStorage(STORAGE_TEXT) { mNumber.u = 0; }
+        Field(char const* value, enum DataTypes type) : mValue(value), mType(type), mStorage(STORAGE_TEXT) { mNumber.u = 0; }
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
-        bool IsNULL() const { return mValue == nullptr; }
+        bool IsNULL() const { return mStorage == STORAGE_TEXT && mValue == nullptr; }
 
-        char const* GetString() const { return mValue; }
+        char const* GetString() const
+        {
+            if (mStorage != STORAGE_TEXT && !mValue)
+                FormatNumber();
+            return mValue;
+        }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            char const* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
+        }
+        float GetFloat() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return GetNumber<float>();
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        bool GetBool() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_INT64:  return mNumber.i > 0;
+                case STORAGE_UINT64: return mNumber.u > 0;
+                case STORAGE_FLOAT:
+                case STORAGE_DOUBLE: return mNumber.d > 0.0;
+                default:             return mValue ? int64(ParseInteger(mValue)) > 0 : false;
+            }
+        }
+        int32 GetInt32() const { return GetInteger<int32>(); }
+        uint8 GetUInt8() const { return GetInteger<uint8>(); }
+        uint16 GetUInt16() const { return GetInteger<uint16>(); }
+        int16 GetInt16() const { return GetInteger<int16>(); }
+        uint32 GetUInt32() const { return GetInteger<uint32>(); }
         uint64 GetUInt64() const
         {
-            uint64 value = 0;
-            if(!mValue || sscanf(mValue,UI64FMTD,&value) == -1)
-                return 0;
+            if (mStorage != STORAGE_TEXT)
+                return GetNumber<uint64>();
 
-            return value;
+            return mValue ? ParseInteger(mValue) : uint64(0);
         }
 
         void SetType(enum DataTypes type) { mType = type; }
         //no need for memory allocations to store resultset field strings
         //all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(char const* value) { mValue = value; };
+        void SetValue(char const* value) { mValue = value; mStorage = STORAGE_TEXT; };
+
+        //numbers are stored as they were received or parsed, with their text if there is one,
+        //otherwise the text is only built if GetString() is called
+        void SetInt64(int64 value, char const* text = nullptr) { mNumber.i = value; mValue = text; mStorage = STORAGE_INT64; }
+        void SetUInt64(uint64 value, char const* text = nullptr) { mNumber.u = value; mValue = text; mStorage = STORAGE_UINT64; }
+        void SetFloat(float value, char const* text = nullptr) { mNumber.d = value; mValue = text; mStorage = STORAGE_FLOAT; }
+        void SetDouble(double value, char const* text = nullptr) { mNumber.d = value; mValue = text; mStorage = STORAGE_DOUBLE; }
+
+        // integer of the text protocol, stops at the first non digit
+        // negative values wrap around like with strtoul
+        static uint64 ParseInteger(char const* text)
+        {
+            bool negative = *text == '-';
+            if (negative || *text == '+')
+                ++text;
+
+            uint64 value = 0;
+            for (uint8 digit; (digit = uint8(*text - '0')) < 10; ++text)
+                value = value * 10 + digit;
+
+            return negative ? 0 - value : value;
+        }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
-        char const* mValue;
+        enum Storage
+        {
+            STORAGE_TEXT,
+            STORAGE_INT64,
+            STORAGE_UINT64,
+            STORAGE_FLOAT,                                  // single precision column, kept in mNumber.d
+            STORAGE_DOUBLE
+        };
+
+        template<typename T>
+        T GetNumber() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_INT64:  return static_cast<T>(mNumber.i);
+                case STORAGE_UINT64: return static_cast<T>(mNumber.u);
+                default:             return static_cast<T>(mNumber.d);
+            }
+        }
+
+        template<typename T>
+        T GetInteger() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return mStorage == STORAGE_FLOAT || mStorage == STORAGE_DOUBLE ? static_cast<T>(static_cast<int64>(mNumber.d)) : GetNumber<T>();
+            return mValue ? static_cast<T>(ParseInteger(mValue)) : T(0);
+        }
+
+        void FormatNumber() const;
+
+        mutable char const* mValue;
         enum DataTypes mType;
+        Storage mStorage;
+        union
+        {
+            int64 i;
+            uint64 u;
+            double d;
+        } mNumber;
+        mutable char mText[24];                             // GetString() of a number
 };
 #endif
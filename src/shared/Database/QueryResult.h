@@ -49,6 +49,100 @@ class QueryResult
         uint64 mRowCount;
 };
 
+// Result set copied once, when it is created, to one typed buffer per column:
+// the Field getters then return the stored number without parsing any text.
+// Used for the prepared statement results, which must not depend on the statement;
+// text results convert each row when it is fetched instead.
+class QueryResultTyped : public QueryResult
+{
+    public:
+        enum ColumnKind
+        {
+            COLUMN_INT64,
+            COLUMN_UINT64,
+            COLUMN_FLOAT,                                   // stored as a double in the cell
+            COLUMN_DOUBLE,
+            COLUMN_STRING
+        };
+
+        QueryResultTyped(uint64 rowCount, uint32 fieldCount)
+            : QueryResult(rowCount, fieldCount), mColumns(fieldCount, COLUMN_STRING), mCells(size_t(rowCount) * fieldCount), mNextRow(0)
+        {
+            mCurrentRow = new Field[mFieldCount];
+        }
+
+        ~QueryResultTyped() override { delete [] mCurrentRow; }
+
+        bool NextRow() override
+        {
+            if (!mCurrentRow)
+                return false;
+
+            if (mNextRow >= mRowCount)
+            {
+                delete [] mCurrentRow;
+                mCurrentRow = nullptr;
+                return false;
+            }
+
+            size_t row = size_t(mNextRow++);
+            for (uint32 i = 0; i < mFieldCount; i++)
+            {
+                Cell const& cell = GetCell(i, row);
+                if (cell.isNull)
+                {
+                    mCurrentRow[i].SetValue(nullptr);
+                    continue;
+                }
+
+                switch (mColumns[i])
+                {
+                    case COLUMN_INT64:  mCurrentRow[i].SetInt64(cell.value.i);  break;
+                    case COLUMN_UINT64: mCurrentRow[i].SetUInt64(cell.value.u); break;
+                    case COLUMN_FLOAT:  mCurrentRow[i].SetFloat(float(cell.value.d)); break;
+                    case COLUMN_DOUBLE: mCurrentRow[i].SetDouble(cell.value.d); break;
+                    case COLUMN_STRING: mCurrentRow[i].SetValue(cell.value.s);  break;
+                }
+            }
+
+            return true;
+        }
+
+    protected:
+        struct Cell
+        {
+            union
+            {
+                int64 i;
+                uint64 u;
+                double d;
+                char const* s;
+            } value;
+            bool isNull;
+        };
+
+        // column after column
+        Cell& GetCell(uint32 column, size_t row) { return mCells[column * size_t(mRowCount) + row]; }
+
+        // for results shorter than announced
+        void SetRowCount(uint64 rowCount)
+        {
+            if (rowCount >= mRowCount)
+                return;
+
+            std::vector<Cell> cells(size_t(rowCount) * mFieldCount);
+            for (uint32 i = 0; i < mFieldCount; i++)
+                for (size_t row = 0; row < rowCount; row++)
+                    cells[i * size_t(rowCount) + row] = GetCell(i, row);
+            mCells.swap(cells);
+            mRowCount = rowCount;
+        }
+
+        std::vector<ColumnKind> mColumns;
+        std::vector<Cell> mCells;
+        uint64 mNextRow;
+};
+
 typedef std::vector<std::string> QueryFieldNames;
 
 class QueryNamedResult
@@ -75,7 +75,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -105,4 +105,222 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+//////////////////////////////////////////////////////////////////////////
+static QueryResultTyped::ColumnKind GetColumnKind(MYSQL_FIELD const& field)
+{
+    switch (field.type)
+    {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONGLONG:
+            return (field.flags & UNSIGNED_FLAG) ? QueryResultTyped::COLUMN_UINT64 : QueryResultTyped::COLUMN_INT64;
+        case MYSQL_TYPE_FLOAT:
+            return QueryResultTyped::COLUMN_FLOAT;
+        case MYSQL_TYPE_DOUBLE:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+            return QueryResultTyped::COLUMN_DOUBLE;
+        default:
+            return QueryResultTyped::COLUMN_STRING;
+    }
+}
+
+QueryResultMysqlTyped::QueryResultMysqlTyped(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mResult(result), mColumns(fieldCount)
+{
+    mCurrentRow = new Field[mFieldCount];
+
+    for (uint32 i = 0; i < mFieldCount; i++)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+        mColumns[i] = GetColumnKind(fields[i]);
+    }
+}
+
+QueryResultMysqlTyped::~QueryResultMysqlTyped()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlTyped::NextRow()
+{
+    if (!mResult)
+        return false;
+
+    MYSQL_ROW row = mysql_fetch_row(mResult);
+    if (!row)
+    {
+        EndQuery();
+        return false;
+    }
+
+    // the text stays available for GetString()
+    for (uint32 i = 0; i < mFieldCount; i++)
+    {
+        char const* value = row[i];
+        if (!value)
+        {
+            mCurrentRow[i].SetValue(nullptr);
+            continue;
+        }
+
+        switch (mColumns[i])
+        {
+            case QueryResultTyped::COLUMN_INT64:  mCurrentRow[i].SetInt64(int64(Field::ParseInteger(value)), value); break;
+            case QueryResultTyped::COLUMN_UINT64: mCurrentRow[i].SetUInt64(Field::ParseInteger(value), value);       break;
+            case QueryResultTyped::COLUMN_FLOAT:  mCurrentRow[i].SetFloat(float(atof(value)), value);               break;
+            case QueryResultTyped::COLUMN_DOUBLE: mCurrentRow[i].SetDouble(atof(value), value);                     break;
+            case QueryResultTyped::COLUMN_STRING: mCurrentRow[i].SetValue(value);                                   break;
+        }
+    }
+
+    return true;
+}
+
+void QueryResultMysqlTyped::EndQuery()
+{
+    delete [] mCurrentRow;
+    mCurrentRow = nullptr;
+
+    if (mResult)
+    {
+        mysql_free_result(mResult);
+        mResult = nullptr;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount) :
+    QueryResultTyped(rowCount, fieldCount), mValid(true)
+{
+    MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+    for (uint32 i = 0; i < mFieldCount; i++)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+        mColumns[i] = GetColumnKind(fields[i]);
+    }
+
+    FetchRows(stmt, fields);
+}
+
+void QueryResultMysqlStmt::FetchRows(MYSQL_STMT* stmt, MYSQL_FIELD* fields)
+{
+    if (!mFieldCount)
+        return;
+
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<Cell> row(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::vector<my_bool> nulls(mFieldCount);
+    std::vector<my_bool> errors(mFieldCount);
+    std::vector<std::vector<char> > buffers(mFieldCount);
+    std::vector<char> longValue;                            // truncated values, the bound buffers must not move
+
+    memset(&binds[0], 0, sizeof(MYSQL_BIND) * mFieldCount);
+    for (uint32 i = 0; i < mFieldCount; i++)
+    {
+        MYSQL_BIND& bind = binds[i];
+        bind.length = &lengths[i];
+        bind.is_null = &nulls[i];
+        bind.error = &errors[i];
+
+        switch (mColumns[i])
+        {
+            case COLUMN_INT64:
+            case COLUMN_UINT64:
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.is_unsigned = mColumns[i] == COLUMN_UINT64;
+                bind.buffer = &row[i].value;
+                break;
+            case COLUMN_FLOAT:
+            case COLUMN_DOUBLE:
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &row[i].value;
+                break;
+            case COLUMN_STRING:
+                // longer values are truncated then fetched again with a big enough buffer
+                buffers[i].resize(std::min<unsigned long>(fields[i].length, 255) + 1);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &buffers[i][0];
+                bind.buffer_length = buffers[i].size();
+                break;
+        }
+    }
+
+    if (mysql_stmt_bind_result(stmt, &binds[0]))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mValid = false;
+        return;
+    }
+
+    size_t rowIndex = 0;
+    for (; rowIndex < mRowCount; ++rowIndex)
+    {
+        int status = mysql_stmt_fetch(stmt);
+        if (status == MYSQL_NO_DATA)
+            break;
+        if (status == 1)
+        {
+            sLog.outError("SQL ERROR: mysql_stmt_fetch() failed");
+            sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+            mValid = false;
+            break;
+        }
+
+        for (uint32 i = 0; i < mFieldCount; i++)
+        {
+            Cell& cell = GetCell(i, rowIndex);
+            cell = row[i];
+            cell.isNull = nulls[i] != 0;
+            if (!cell.isNull && mColumns[i] == COLUMN_STRING)
+            {
+                char const* value = &buffers[i][0];
+                unsigned long length = lengths[i];
+                if (errors[i])
+                {
+                    longValue.resize(length + 1);
+                    MYSQL_BIND bind;
+                    memset(&bind, 0, sizeof(bind));
+                    bind.buffer_type = MYSQL_TYPE_STRING;
+                    bind.buffer = &longValue[0];
+                    bind.buffer_length = longValue.size();
+                    bind.length = &length;
+                    if (mysql_stmt_fetch_column(stmt, &bind, i, 0))
+                    {
+                        sLog.outError("SQL ERROR: mysql_stmt_fetch_column() failed");
+                        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+                        mValid = false;
+                        length = 0;
+                    }
+                    value = &longValue[0];
+                }
+
+                // offset until all the strings are copied
+                cell.value.u = mText.size();
+                mText.insert(mText.end(), value, value + length);
+                mText.push_back('\0');
+            }
+        }
+    }
+
+    SetRowCount(rowIndex);
+
+    for (uint32 i = 0; i < mFieldCount; i++)
+    {
+        if (mColumns[i] != COLUMN_STRING)
+            continue;
+
+        for (size_t r = 0; r < mRowCount; ++r)
+        {
+            Cell& cell = GetCell(i, r);
+            if (!cell.isNull)
+                cell.value.s = &mText[cell.value.u];
+        }
+    }
+}
 #endif
@@ -40,11 +40,49 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
 };
+
+// Text protocol result set whose numeric columns are parsed once, when their row is fetched.
+// Nothing is copied, the values stay in the MYSQL_RES.
+class QueryResultMysqlTyped : public QueryResult
+{
+    public:
+        QueryResultMysqlTyped(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+
+        ~QueryResultMysqlTyped() override;
+
+        bool NextRow() override;
+
+    private:
+        void EndQuery();
+
+        MYSQL_RES* mResult;
+        std::vector<QueryResultTyped::ColumnKind> mColumns;
+};
+
+// Result set of a prepared statement, received with the binary protocol.
+// The rows are copied when the result is created, so the statement can be executed again
+// while the result is still used.
+class QueryResultMysqlStmt : public QueryResultTyped
+{
+    public:
+        // stmt is executed and its result stored (mysql_stmt_store_result)
+        QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount);
+
+        // false if a row could not be fetched, the result is then incomplete
+        bool IsValid() const { return mValid; }
+
+    private:
+        void FetchRows(MYSQL_STMT* stmt, MYSQL_FIELD* fields);
+
+        std::vector<char> mText;                            // zero terminated strings
+        bool mValid;
+};
 #endif
 #endif
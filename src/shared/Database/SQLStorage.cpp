@@ -17,6 +17,8 @@
  */
 
 #include "SQLStorage.h"
+#include <algorithm>
+#include <cstdio>
 
 // -----------------------------------  SQLStorageBase  ---------------------------------------- //
 
@@ -120,6 +122,274 @@ void SQLStorageBase::Free()
     m_recordCount = 0;
 }
 
+// -----------------------------------  Snapshots  -------------------------------------------- //
+
+std::string SQLStorageBase::s_snapshotDirectory;
+
+namespace
+{
+    uint32 const SNAPSHOT_MAGIC = 0x534C5153;               // "SQLS"
+    uint32 const SNAPSHOT_VERSION = 1;
+
+    uint32 GetDstFieldSize(char format)
+    {
+        switch (format)
+        {
+            case FT_LOGIC:
+                return sizeof(bool);
+            case FT_BYTE:
+            case FT_NA_BYTE:
+                return sizeof(char);
+            case FT_INT:
+            case FT_NA:
+                return sizeof(uint32);
+            case FT_FLOAT:
+            case FT_NA_FLOAT:
+                return sizeof(float);
+            case FT_STRING:
+            case FT_NA_POINTER:
+                return sizeof(char*);
+            case FT_64BITINT:
+                return sizeof(uint64);
+            default:
+                assert(false && "unknown format character");
+                return 0;
+        }
+    }
+
+    class SnapshotReader
+    {
+        public:
+            SnapshotReader(std::vector<char> const& data) : m_data(data), m_pos(0) {}
+
+            bool Read(void* dst, size_t size)
+            {
+                if (m_data.size() - m_pos < size)
+                    return false;
+                memcpy(dst, &m_data[m_pos], size);
+                m_pos += size;
+                return true;
+            }
+
+            bool ReadUInt32(uint32& value) { return Read(&value, sizeof(value)); }
+
+            bool ReadString(std::string& value)
+            {
+                uint32 length;
+                if (!ReadUInt32(length) || m_data.size() - m_pos < length)
+                    return false;
+                value.assign(&m_data[m_pos], length);
+                m_pos += length;
+                return true;
+            }
+
+            bool AtEnd() const { return m_pos == m_data.size(); }
+
+        private:
+            std::vector<char> const& m_data;
+            size_t m_pos;
+    };
+
+    void WriteUInt32(std::string& data, uint32 value)
+    {
+        data.append(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::string& data, char const* value)
+    {
+        uint32 length = value ? strlen(value) : 0;
+        WriteUInt32(data, length);
+        data.append(value ? value : "", length);
+    }
+}
+
+void SQLStorageBase::GetSnapshotFields(std::vector<SnapshotField>& stringFields, std::vector<SnapshotField>& convertedFields) const
+{
+    uint32 offset = 0;
+    for (uint32 x = 0, y = 0; x < m_dstFieldCount; ++x)
+    {
+        char const dst = m_dst_format[x];
+        SnapshotField field = { x, offset };
+        offset += GetDstFieldSize(dst);
+
+        if (dst == FT_STRING || dst == FT_NA_POINTER)
+            stringFields.push_back(field);
+
+        // Same walk over the source fields as the loader
+        if (dst == FT_NA || dst == FT_NA_BYTE || dst == FT_NA_FLOAT || dst == FT_NA_POINTER)
+            continue;
+        while (y < m_srcFieldCount && (m_src_format[y] == FT_NA || m_src_format[y] == FT_NA_BYTE || m_src_format[y] == FT_NA_FLOAT))
+            ++y;
+        if (y < m_srcFieldCount && m_src_format[y] == FT_STRING && dst != FT_STRING)
+            convertedFields.push_back(field);
+        ++y;
+    }
+}
+
+std::string SQLStorageBase::GetSnapshotFileName() const
+{
+    return s_snapshotDirectory + m_tableName + ".snapshot";
+}
+
+uint64 SQLStorageBase::GetTableChecksum() const
+{
+#ifndef DO_POSTGRESQL
+    if (s_snapshotDirectory.empty())
+        return 0;
+
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", m_tableName);
+    if (!result)
+        return 0;
+
+    uint64 checksum = (*result)[1].GetUInt64();
+    delete result;
+    return checksum;
+#else
+    return 0;
+#endif
+}
+
+bool SQLStorageBase::ReadSnapshot(std::string const& key, uint64 checksum, std::vector<std::string>& convertedStrings)
+{
+    std::vector<char> data;
+    {
+        FILE* file = fopen(GetSnapshotFileName().c_str(), "rb");
+        if (!file)
+            return false;
+
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0)
+        {
+            data.resize(size);
+            if (fread(&data[0], 1, size, file) != size_t(size))
+                data.clear();
+        }
+        fclose(file);
+    }
+
+    SnapshotReader reader(data);
+    uint32 magic, version, pointerSize, recordSize, recordCount, maxEntry;
+    uint64 fileChecksum;
+    std::string fileKey;
+    std::string const fullKey = key + "|" + m_src_format + "|" + m_dst_format;
+    if (!reader.ReadUInt32(magic) || magic != SNAPSHOT_MAGIC ||
+            !reader.ReadUInt32(version) || version != SNAPSHOT_VERSION ||
+            !reader.ReadUInt32(pointerSize) || pointerSize != sizeof(char*) ||
+            !reader.Read(&fileChecksum, sizeof(fileChecksum)) || fileChecksum != checksum ||
+            !reader.ReadString(fileKey) || fileKey != fullKey ||
+            !reader.ReadUInt32(recordSize) || !reader.ReadUInt32(recordCount) || !reader.ReadUInt32(maxEntry))
+        return false;
+
+    std::vector<SnapshotField> stringFields, convertedFields;
+    GetSnapshotFields(stringFields, convertedFields);
+
+    uint32 expectedSize = 0;
+    for (uint32 x = 0; x < m_dstFieldCount; ++x)
+        expectedSize += GetDstFieldSize(m_dst_format[x]);
+    if (recordSize != expectedSize || uint64(recordCount) * (sizeof(uint32) + recordSize) > data.size())
+        return false;
+
+    prepareToLoad(maxEntry, recordCount, recordSize);
+    convertedStrings.resize(recordCount * convertedFields.size());
+
+    bool valid = true;
+    std::string value;
+    for (uint32 i = 0; valid && i < recordCount; ++i)
+    {
+        uint32 id;
+        if (!reader.ReadUInt32(id) || id >= maxEntry)
+        {
+            valid = false;
+            break;
+        }
+
+        char* record = createRecord(id);
+        if (!reader.Read(record, recordSize))
+        {
+            valid = false;
+            break;
+        }
+
+        // The pointers of the file are not valid anymore
+        for (SnapshotField const& field : stringFields)
+            *reinterpret_cast<char**>(record + field.offset) = nullptr;
+
+        for (SnapshotField const& field : stringFields)
+        {
+            if (!reader.ReadString(value))
+            {
+                valid = false;
+                break;
+            }
+            char* str = new char[value.size() + 1];
+            memcpy(str, value.c_str(), value.size() + 1);
+            *reinterpret_cast<char**>(record + field.offset) = str;
+        }
+
+        for (size_t j = 0; valid && j < convertedFields.size(); ++j)
+            valid = reader.ReadString(convertedStrings[i * convertedFields.size() + j]);
+    }
+
+    if (!valid || !reader.AtEnd())
+    {
+        Free();
+        return false;
+    }
+
+    finishLoading();
+    return true;
+}
+
+void SQLStorageBase::WriteSnapshot(std::string const& key, uint64 checksum, std::vector<uint32> const& ids, std::vector<std::string> const& convertedStrings) const
+{
+    std::vector<SnapshotField> stringFields, convertedFields;
+    GetSnapshotFields(stringFields, convertedFields);
+    if (ids.size() != m_recordCount || convertedStrings.size() != m_recordCount * convertedFields.size())
+        return;
+
+    std::string data;
+    WriteUInt32(data, SNAPSHOT_MAGIC);
+    WriteUInt32(data, SNAPSHOT_VERSION);
+    WriteUInt32(data, sizeof(char*));
+    data.append(reinterpret_cast<char const*>(&checksum), sizeof(checksum));
+    WriteString(data, (key + "|" + m_src_format + "|" + m_dst_format).c_str());
+    WriteUInt32(data, m_recordSize);
+    WriteUInt32(data, m_recordCount);
+    WriteUInt32(data, m_maxEntry);
+
+    for (uint32 i = 0; i < m_recordCount; ++i)
+    {
+        char const* record = m_data + i * m_recordSize;
+        WriteUInt32(data, ids[i]);
+        data.append(record, m_recordSize);
+        for (SnapshotField const& field : stringFields)
+            WriteString(data, *reinterpret_cast<char* const*>(record + field.offset));
+        for (size_t j = 0; j < convertedFields.size(); ++j)
+            WriteString(data, convertedStrings[i * convertedFields.size() + j].c_str());
+    }
+
+    // Written aside then renamed, a server stopped while writing leaves the old snapshot
+    std::string const fileName = GetSnapshotFileName();
+    std::string const tmpFileName = fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can't write the snapshot of %s in %s", m_tableName, tmpFileName.c_str());
+        return;
+    }
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = fclose(file) == 0 && written;
+
+    remove(fileName.c_str());
+    if (!written || rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can't write the snapshot of %s in %s", m_tableName, fileName.c_str());
+        remove(tmpFileName.c_str());
+    }
+}
+
 // -----------------------------------  SQLStorage  -------------------------------------------- //
 
 void SQLStorage::EraseEntry(uint32 id)
@@ -244,3 +514,86 @@ SQLMultiStorage::SQLMultiStorage(char const* src_fmt, char const* dst_fmt, char
 {
     Initialize(sqlname, _entry_field, src_fmt, dst_fmt);
 }
+
+// -----------------------------------  SQLSortedStorage  -------------------------------------- //
+void SQLSortedStorage::Load(bool error_at_empty /*= true*/)
+{
+    SQLSortedStorageLoader loader;
+    loader.Load(*this, error_at_empty);
+}
+
+void SQLSortedStorage::LoadProgressive(uint32 wow_patch, std::string column_name /*= "patch"*/, bool error_at_empty /*= true*/)
+{
+    SQLSortedStorageLoader loader;
+    loader.LoadProgressive(*this, wow_patch, column_name, error_at_empty);
+}
+
+void SQLSortedStorage::Free()
+{
+    SQLStorageBase::Free();
+    m_index.clear();
+    m_buckets.clear();
+    m_minId = 0;
+    m_shift = 0;
+}
+
+void SQLSortedStorage::prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize)
+{
+    // Clear (possible) old data and old index array
+    Free();
+    m_index.reserve(recordCount);
+
+    SQLStorageBase::prepareToLoad(maxRecordId, recordCount, recordSize);
+}
+
+void SQLSortedStorage::finishLoading()
+{
+    std::stable_sort(m_index.begin(), m_index.end(), [](IndexEntry const& a, IndexEntry const& b) { return a.id < b.id; });
+
+    // The last record of an id replaces the previous ones, as in SQLStorage
+    size_t count = 0;
+    for (size_t i = 0; i < m_index.size(); ++i)
+    {
+        if (count && m_index[count - 1].id == m_index[i].id)
+            m_index[count - 1] = m_index[i];
+        else
+            m_index[count++] = m_index[i];
+    }
+    m_index.resize(count);
+    m_index.shrink_to_fit();
+
+    if (m_index.empty())
+        return;
+
+    // At most two buckets by record
+    m_minId = m_index.front().id;
+    uint64 const span = uint64(m_index.back().id - m_minId) + 1;
+    while ((span >> m_shift) > 2 * m_index.size())
+        ++m_shift;
+
+    uint32 const bucketCount = uint32((span - 1) >> m_shift) + 1;
+    m_buckets.resize(bucketCount + 1);
+    uint32 next = 0;
+    for (uint32 bucket = 0; bucket <= bucketCount; ++bucket)
+    {
+        while (next < m_index.size() && ((m_index[next].id - m_minId) >> m_shift) < bucket)
+            ++next;
+        m_buckets[bucket] = next;
+    }
+}
+
+void SQLSortedStorage::EraseEntry(uint32 id)
+{
+    if (IndexEntry const* entry = FindEntry(id))
+        m_index[entry - m_index.data()].position = ERASED_RECORD;
+}
+
+SQLSortedStorage::SQLSortedStorage(char const* fmt, char const* _entry_field, char const* sqlname) : m_minId(0), m_shift(0)
+{
+    Initialize(sqlname, _entry_field, fmt, fmt);
+}
+
+SQLSortedStorage::SQLSortedStorage(char const* src_fmt, char const* dst_fmt, char const* _entry_field, char const* sqlname) : m_minId(0), m_shift(0)
+{
+    Initialize(sqlname, _entry_field, src_fmt, dst_fmt);
+}
@@ -39,6 +39,9 @@ class SQLStorageBase
         uint32 GetMaxEntry() const { return m_maxEntry; };
         uint32 GetRecordCount() const { return m_recordCount; };
 
+        // Directory of the table snapshots, empty to always load the tables from the database
+        static void SetSnapshotDirectory(std::string const& directory) { s_snapshotDirectory = directory; }
+
         template<typename T>
         class SQLSIterator
         {
@@ -78,11 +81,36 @@ class SQLStorageBase
 
         virtual void prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize);
         virtual void JustCreatedRecord(uint32 recordId, char* record) = 0;
+        virtual void finishLoading() {}                     // all the records are created
         virtual void Free();
 
+        char* getRecord(uint32 position) const { return m_data + position * m_recordSize; }
+
     private:
         char* createRecord(uint32 recordId);
 
+        /**
+         * A snapshot is a file with the records as they were loaded from the table, reused
+         * instead of the table as long as CHECKSUM TABLE returns the same value. The strings
+         * converted to an other type by the loader (script names) are kept as strings and
+         * converted again, the loader may not give the same value anymore.
+         */
+        uint64 GetTableChecksum() const;                    // 0 when snapshots are not used
+        // convertedStrings: for each record, the source of the fields in convertedFields
+        bool ReadSnapshot(std::string const& key, uint64 checksum, std::vector<std::string>& convertedStrings);
+        void WriteSnapshot(std::string const& key, uint64 checksum, std::vector<uint32> const& ids, std::vector<std::string> const& convertedStrings) const;
+        std::string GetSnapshotFileName() const;
+
+        struct SnapshotField
+        {
+            uint32 index;                                   // dst field
+            uint32 offset;                                  // in the record
+        };
+        // dst fields holding a char*, and non string dst fields loaded from a string
+        void GetSnapshotFields(std::vector<SnapshotField>& stringFields, std::vector<SnapshotField>& convertedFields) const;
+
+        static std::string s_snapshotDirectory;
+
         // Information about the table
         char const* m_tableName;
         char const* m_entry_field;
@@ -247,6 +275,78 @@ class SQLMultiStorage : public SQLStorageBase
         RecordMultiMap m_indexMultiMap;
 };
 
+/**
+ * @brief Storage for the tables with a sparse id space.
+ *
+ * Instead of an index sized to the biggest id, the ids and the positions of their records
+ * are kept sorted, 8 bytes by record. A directory splits the id range in at most two buckets
+ * by record and gives the first index of each one, so a lookup reads the directory then
+ * scans the few ids of one bucket.
+ */
+class SQLSortedStorage : public SQLStorageBase
+{
+        template<class DerivedLoader, class StorageClass> friend class SQLStorageLoaderBase;
+
+    public:
+        SQLSortedStorage(char const* fmt, char const* _entry_field, char const* sqlname);
+        SQLSortedStorage(char const* src_fmt, char const* dst_fmt, char const* _entry_field, char const* sqlname);
+
+        ~SQLSortedStorage() override { Free(); }
+
+        template<class T>
+        T const* LookupEntry(uint32 id) const
+        {
+            IndexEntry const* entry = FindEntry(id);
+            if (!entry || entry->position == ERASED_RECORD)
+                return nullptr;
+            return reinterpret_cast<T const*>(getRecord(entry->position));
+        }
+
+        void Load(bool error_at_empty = true);
+        void LoadProgressive(uint32 wow_patch, std::string column_name = "patch", bool error_at_empty = true);
+
+        void EraseEntry(uint32 id);
+
+    protected:
+        void prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize) override;
+        void JustCreatedRecord(uint32 recordId, char* /*record*/) override
+        {
+            m_index.push_back({ recordId, GetRecordCount() - 1 });
+        }
+        void finishLoading() override;
+
+        void Free() override;
+
+    private:
+        static uint32 const ERASED_RECORD = 0xFFFFFFFF;
+
+        struct IndexEntry
+        {
+            uint32 id;
+            uint32 position;                                // of the record in the storage
+        };
+
+        IndexEntry const* FindEntry(uint32 id) const
+        {
+            if (m_buckets.empty() || id < m_minId)
+                return nullptr;
+
+            uint32 const bucket = (id - m_minId) >> m_shift;
+            if (bucket + 1 >= m_buckets.size())
+                return nullptr;
+
+            for (uint32 i = m_buckets[bucket], end = m_buckets[bucket + 1]; i < end; ++i)
+                if (m_index[i].id >= id)
+                    return m_index[i].id == id ? &m_index[i] : nullptr;
+            return nullptr;
+        }
+
+        std::vector<IndexEntry> m_index;                    // sorted by id once loaded
+        std::vector<uint32> m_buckets;                      // first index of each bucket, and the end
+        uint32 m_minId;
+        uint32 m_shift;                                     // bucket of an id: (id - m_minId) >> m_shift
+};
+
 template <class DerivedLoader, class StorageClass>
 class SQLStorageLoaderBase
 {
@@ -274,6 +374,8 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        bool LoadSnapshot(StorageClass& store, std::string const& key, uint64 checksum);
+
         template<class V>
         void storeValue(V value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
         void storeValue(char const* value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
@@ -294,6 +396,10 @@ class SQLMultiStorageLoader : public SQLStorageLoaderBase<SQLMultiStorageLoader,
 {
 };
 
+class SQLSortedStorageLoader : public SQLStorageLoaderBase<SQLSortedStorageLoader, SQLSortedStorage>
+{
+};
+
 #include "SQLStorageImpl.h"
 
 #endif
@@ -186,9 +186,41 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
     }
 }
 
+template<class DerivedLoader, class StorageClass>
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadSnapshot(StorageClass& store, std::string const& key, uint64 checksum)
+{
+    std::vector<std::string> convertedStrings;
+    if (!store.ReadSnapshot(key, checksum, convertedStrings))
+        return false;
+
+    // The strings converted by the loader, script names to script ids
+    std::vector<SQLStorageBase::SnapshotField> stringFields, convertedFields;
+    store.GetSnapshotFields(stringFields, convertedFields);
+    if (!convertedFields.empty())
+    {
+        for (uint32 i = 0; i < store.GetRecordCount(); ++i)
+        {
+            char* record = store.m_data + i * store.GetRecordSize();
+            for (size_t j = 0; j < convertedFields.size(); ++j)
+            {
+                uint32 offset = convertedFields[j].offset;
+                storeValue(convertedStrings[i * convertedFields.size() + j].c_str(), store, record, convertedFields[j].index, offset);
+            }
+        }
+    }
+
+    sLog.outString("%s: %u records loaded from the snapshot", store.GetTableName(), store.GetRecordCount());
+    return true;
+}
+
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    uint64 const checksum = store.GetTableChecksum();
+    std::string const snapshotKey = store.GetTableName();
+    if (checksum && LoadSnapshot(store, snapshotKey, checksum))
+        return;
+
     Field* fields = nullptr;
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!result)
@@ -272,13 +304,18 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    std::vector<uint32> snapshotIds;
+    std::vector<std::string> snapshotStrings;
     BarGoLink bar(recordCount);
     do
     {
         fields = result->Fetch();
         bar.step();
 
-        char* record = store.createRecord(fields[0].GetUInt32());
+        uint32 const recordId = fields[0].GetUInt32();
+        char* record = store.createRecord(recordId);
+        if (checksum)
+            snapshotIds.push_back(recordId);
         offset = 0;
 
         // dependend on dest-size
@@ -308,7 +345,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
                 case FT_BYTE:   storeValue((char)fields[y].GetUInt8(), store, record, x, offset);         ++x; break;
                 case FT_INT:    storeValue((uint32)fields[y].GetUInt32(), store, record, x, offset);      ++x; break;
                 case FT_FLOAT:  storeValue((float)fields[y].GetFloat(), store, record, x, offset);        ++x; break;
-                case FT_STRING: storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
+                case FT_STRING:
+                    if (checksum && store.GetDstFormat(x) != FT_STRING)
+                        snapshotStrings.push_back(fields[y].GetCppString());
+                    storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
                 case FT_64BITINT: storeValue(fields[y].GetUInt64(), store, record, x, offset);            ++x; break;
                 case FT_NA:
                 case FT_NA_BYTE:
@@ -329,12 +369,21 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+    store.finishLoading();
+
+    if (checksum)
+        store.WriteSnapshot(snapshotKey, checksum, snapshotIds, snapshotStrings);
 }
 
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageClass& store, uint32 wow_patch, std::string column_name /* = "patch" */, bool error_at_empty /*= true*/)
 {
     // To be used on tables that need to support patch progression. Second column must be the `patch` column.
+    uint64 const checksum = store.GetTableChecksum();
+    std::string const snapshotKey = std::string(store.GetTableName()) + " " + column_name + "<=" + std::to_string(wow_patch);
+    if (checksum && LoadSnapshot(store, snapshotKey, checksum))
+        return;
+
     Field* fields = nullptr;
     QueryResult* result = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s t1 WHERE %s=(SELECT max(%s) FROM %s t2 WHERE t1.%s=t2.%s && %s <= %u)", store.EntryFieldName(), store.GetTableName(), column_name.c_str(), column_name.c_str(), store.GetTableName(), store.EntryFieldName(), store.EntryFieldName(), column_name.c_str(), wow_patch);
     if (!result)
@@ -419,13 +468,18 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageC
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
     uint8 patchoffset = 0;
+    std::vector<uint32> snapshotIds;
+    std::vector<std::string> snapshotStrings;
     BarGoLink bar(recordCount);
     do
     {
         fields = result->Fetch();
         bar.step();
 
-        char* record = store.createRecord(fields[0].GetUInt32());
+        uint32 const recordId = fields[0].GetUInt32();
+        char* record = store.createRecord(recordId);
+        if (checksum)
+            snapshotIds.push_back(recordId);
         offset = 0;
         patchoffset = 0;
 
@@ -460,7 +514,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageC
             case FT_BYTE:   storeValue((char)fields[y + patchoffset].GetUInt8(), store, record, x, offset);         ++x; break;
             case FT_INT:    storeValue((uint32)fields[y + patchoffset].GetUInt32(), store, record, x, offset);      ++x; break;
             case FT_FLOAT:  storeValue((float)fields[y + patchoffset].GetFloat(), store, record, x, offset);        ++x; break;
-            case FT_STRING: storeValue((char const*)fields[y + patchoffset].GetString(), store, record, x, offset); ++x; break;
+            case FT_STRING:
+                if (checksum && store.GetDstFormat(x) != FT_STRING)
+                    snapshotStrings.push_back(fields[y + patchoffset].GetCppString());
+                storeValue((char const*)fields[y + patchoffset].GetString(), store, record, x, offset); ++x; break;
             case FT_64BITINT: storeValue(fields[y + patchoffset].GetUInt64(), store, record, x, offset);            ++x; break;
             case FT_NA:
             case FT_NA_BYTE:
@@ -480,6 +537,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageC
     } while (result->NextRow());
 
     delete result;
+    store.finishLoading();
+
+    if (checksum)
+        store.WriteSnapshot(snapshotKey, checksum, snapshotIds, snapshotStrings);
 }
 
 #endif
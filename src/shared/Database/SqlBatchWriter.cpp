@@ -0,0 +1,205 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "DatabaseEnv.h"
+#include "SqlBatchWriter.h"
+
+void SqlBatchRow::separator()
+{
+    m_values += m_values.empty() ? "(" : ", ";
+}
+
+void SqlBatchRow::addUInt32(uint32 value)
+{
+    separator();
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u", value);
+    m_values += buf;
+}
+
+void SqlBatchRow::addInt32(int32 value)
+{
+    separator();
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%i", value);
+    m_values += buf;
+}
+
+void SqlBatchRow::addUInt64(uint64 value)
+{
+    separator();
+    char buf[24];
+    snprintf(buf, sizeof(buf), UI64FMTD, value);
+    m_values += buf;
+}
+
+void SqlBatchRow::addFloat(float value)
+{
+    separator();
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.9g", value);
+    m_values += buf;
+}
+
+void SqlBatchRow::addString(char const* value)
+{
+    addString(std::string(value ? value : ""));
+}
+
+void SqlBatchRow::addString(std::string const& value)
+{
+    separator();
+    std::string escaped(value);
+    m_db.escape_string(escaped);
+    m_values += '\'';
+    m_values += escaped;
+    m_values += '\'';
+}
+
+void SqlBatchRow::addTime(time_t value)
+{
+    separator();
+    char buf[40];
+    snprintf(buf, sizeof(buf), "FROM_UNIXTIME(" UI64FMTD ")", uint64(value));
+    m_values += buf;
+}
+
+std::string const& SqlBatchRow::values()
+{
+    if (!m_values.empty() && m_values.back() != ')')
+        m_values += ')';
+    return m_values;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SqlBatchWriter::SetLimits(uint32 maxRows, uint32 maxBytes, uint32 maxDelay, uint32 maxDbQueue)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_maxRows = maxRows;
+    m_maxBytes = maxBytes;
+    m_maxDelay = maxDelay;
+    m_maxDbQueue = maxDbQueue;
+}
+
+void SqlBatchWriter::Insert(char const* statement, SqlBatchRow& row)
+{
+    Add(statement, nullptr, row);
+}
+
+void SqlBatchWriter::Replace(char const* statement, std::string const& key, SqlBatchRow& row)
+{
+    Add(statement, &key, row);
+}
+
+void SqlBatchWriter::Add(char const* statement, std::string const* key, SqlBatchRow& row)
+{
+    std::string const& values = row.values();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Batch& batch = m_batches[statement];
+    if (batch.statement.empty())
+        batch.statement = statement;
+
+    ++m_rows;
+    if (key)
+    {
+        auto itr = batch.keys.find(*key);
+        if (itr != batch.keys.end())
+        {
+            std::string& queued = batch.rows[itr->second];
+            batch.bytes += values.size() - queued.size();
+            queued = values;
+            ++m_replacedRows;
+            return;
+        }
+        batch.keys[*key] = batch.rows.size();
+    }
+
+    batch.rows.push_back(values);
+    batch.bytes += values.size();
+
+    if (batch.rows.size() >= m_maxRows || (m_maxBytes && batch.bytes >= m_maxBytes))
+        Write(batch);
+}
+
+void SqlBatchWriter::Write(Batch& batch)
+{
+    if (batch.rows.empty())
+        return;
+
+    std::string sql;
+    sql.reserve(batch.statement.size() + batch.bytes + batch.rows.size() * 2);
+    sql = batch.statement;
+    for (size_t i = 0; i < batch.rows.size(); ++i)
+    {
+        if (i)
+            sql += ", ";
+        sql += batch.rows[i];
+    }
+
+    m_db.Execute(sql.c_str());
+    ++m_statements;
+
+    batch.rows.clear();
+    batch.keys.clear();
+    batch.bytes = 0;
+    batch.age = 0;
+}
+
+void SqlBatchWriter::Update(uint32 diff)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool const databaseBusy = m_maxDbQueue && m_db.GetDelayQueueSize() > m_maxDbQueue;
+    for (auto& itr : m_batches)
+    {
+        Batch& batch = itr.second;
+        if (batch.rows.empty())
+            continue;
+
+        batch.age += diff;
+        if (batch.age < m_maxDelay)
+            continue;
+
+        if (databaseBusy)
+        {
+            ++m_deferredFlushes;
+            continue;
+        }
+
+        Write(batch);
+    }
+}
+
+void SqlBatchWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto& itr : m_batches)
+        Write(itr.second);
+}
+
+SqlBatchWriter::Stats SqlBatchWriter::GetStats()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Stats stats;
+    stats.pendingRows = 0;
+    for (auto const& itr : m_batches)
+        stats.pendingRows += itr.second.rows.size();
+    stats.rows = m_rows;
+    stats.replacedRows = m_replacedRows;
+    stats.statements = m_statements;
+    stats.deferredFlushes = m_deferredFlushes;
+    return stats;
+}
@@ -0,0 +1,122 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLBATCHWRITER_H
+#define SQLBATCHWRITER_H
+
+#include "Common.h"
+#include <mutex>
+#include <unordered_map>
+
+class Database;
+
+// Values of one row, formatted as "(1, 'text', ...)"
+class SqlBatchRow
+{
+    public:
+        explicit SqlBatchRow(Database& db) : m_db(db) {}
+
+        void addUInt32(uint32 value);
+        void addInt32(int32 value);
+        void addUInt64(uint64 value);
+        void addFloat(float value);
+        void addString(char const* value);
+        void addString(std::string const& value);
+        void addTime(time_t value);                         // for TIMESTAMP columns, rows are written later than queued
+
+        std::string const& values();
+
+    private:
+        void separator();
+
+        Database& m_db;
+        std::string m_values;
+};
+
+/**
+ * @brief Groups the rows inserted in a table into multi-row statements.
+ *
+ * The rows of a table are queued until the batch has MaxRows rows or MaxBytes of values,
+ * then written by one statement in the async queue of the database. Update() writes
+ * the batches older than MaxDelay, unless the async queue of the database has more than
+ * MaxDbQueue statements waiting: the batches then keep growing until a size limit, so a
+ * late database gets fewer and bigger statements. Flush() writes everything, call it
+ * before stopping the database.
+ *
+ * Rows added with a key replace the queued row with the same key, for tables written
+ * with REPLACE INTO where only the last value matters.
+ *
+ * A row reaches the database up to MaxDelay after it was queued (longer with a busy
+ * database), so a column defaulting to CURRENT_TIMESTAMP would get the flush time:
+ * write the event time in the row with addTime() instead.
+ */
+class SqlBatchWriter
+{
+    public:
+        explicit SqlBatchWriter(Database& db) : m_db(db), m_maxRows(0), m_maxBytes(0), m_maxDelay(0), m_maxDbQueue(0),
+            m_rows(0), m_replacedRows(0), m_statements(0), m_deferredFlushes(0) {}
+
+        // 0 rows: every row is written at once
+        void SetLimits(uint32 maxRows, uint32 maxBytes, uint32 maxDelay, uint32 maxDbQueue);
+
+        // statement is the beginning of the query, up to VALUES: "INSERT INTO `t` (`a`, `b`) VALUES "
+        void Insert(char const* statement, SqlBatchRow& row);
+        void Replace(char const* statement, std::string const& key, SqlBatchRow& row);
+
+        // Called by the world thread
+        void Update(uint32 diff);
+        void Flush();
+
+        struct Stats
+        {
+            uint32 pendingRows;
+            uint64 rows;
+            uint64 replacedRows;                            // rows that never reached the database, replaced by a newer value
+            uint64 statements;
+            uint64 deferredFlushes;                         // timed flushes delayed by a busy database
+        };
+        Stats GetStats();
+
+    private:
+        struct Batch
+        {
+            Batch() : bytes(0), age(0) {}
+
+            std::string statement;
+            std::vector<std::string> rows;
+            std::unordered_map<std::string, size_t> keys;   // index in rows
+            size_t bytes;
+            uint32 age;                                     // ms since the first queued row
+        };
+
+        void Add(char const* statement, std::string const* key, SqlBatchRow& row);
+        void Write(Batch& batch);
+
+        Database& m_db;
+        uint32 m_maxRows;
+        uint32 m_maxBytes;
+        uint32 m_maxDelay;
+        uint32 m_maxDbQueue;
+
+        std::mutex m_mutex;
+        std::unordered_map<std::string, Batch> m_batches;
+        uint64 m_rows;
+        uint64 m_replacedRows;
+        uint64 m_statements;
+        uint64 m_deferredFlushes;
+};
+
+#endif
@@ -24,8 +24,11 @@
 #include "DatabaseEnv.h"
 
 SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn)
-    : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+    : m_dbEngine(db), m_dbConnection(conn), m_running(true), m_wakeUpPending(false),
+      m_executed(0), m_totalTimeUs(0), m_maxTimeUs(0)
 {
+    for (uint32 i = 0; i < LATENCY_BUCKETS; ++i)
+        m_latency[i] = 0;
 }
 
 SqlDelayThread::~SqlDelayThread()
@@ -38,6 +41,7 @@ SqlDelayThread::~SqlDelayThread()
 void SqlDelayThread::addSerialOperation(SqlOperation *op)
 {
     m_serialDelayQueue.add(op);
+    WakeUp();
 }
 
 bool SqlDelayThread::HasAsyncQuery()
@@ -45,28 +49,54 @@ bool SqlDelayThread::HasAsyncQuery()
     return !m_serialDelayQueue.empty_unsafe();
 }
 
+void SqlDelayThread::WakeUp()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_wakeUpLock);
+        m_wakeUpPending = true;
+    }
+    m_wakeUp.notify_one();
+}
+
+SqlDelayThread::Stats SqlDelayThread::GetStats()
+{
+    Stats stats;
+    stats.executed = m_executed;
+    stats.totalTimeUs = m_totalTimeUs;
+    stats.maxTimeUs = m_maxTimeUs;
+    for (uint32 i = 0; i < LATENCY_BUCKETS; ++i)
+        stats.latency[i] = m_latency[i];
+    stats.serialQueueSize = m_serialDelayQueue.size();
+    return stats;
+}
+
 void SqlDelayThread::run()
 {
     #ifndef DO_POSTGRESQL
     mysql_thread_init();
     #endif
 
-    uint32 const loopSleepms = 10;
-
-    uint32 const pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    // Queued operations wake the thread up, the timeout only
+    // covers work queued while the woken thread was busy
+    std::chrono::milliseconds const maxSleep(10);
+    std::chrono::milliseconds const pingInterval(m_dbEngine->GetPingIntervall());
 
-    uint32 loopCounter = 0;
+    auto lastPing = std::chrono::steady_clock::now();
     while (m_running)
     {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeUpLock);
+            m_wakeUp.wait_for(lock, maxSleep, [this] { return m_wakeUpPending; });
+            m_wakeUpPending = false;
+        }
+
         // if the running state gets turned off while sleeping
         // empty the queue before exiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(loopSleepms));
-
         ProcessRequests();
 
-        if((loopCounter++) >= pingEveryLoop)
+        if (std::chrono::steady_clock::now() - lastPing >= pingInterval)
         {
-            loopCounter = 0;
+            lastPing = std::chrono::steady_clock::now();
             m_dbEngine->Ping();
             if (QueryResult* res = m_dbConnection->Query("SELECT 1"))
                 delete res;
@@ -81,21 +111,35 @@ void SqlDelayThread::run()
 void SqlDelayThread::Stop()
 {
     m_running = false;
+    WakeUp();
+}
+
+void SqlDelayThread::ExecuteOperation(SqlOperation* op)
+{
+    auto const begin = std::chrono::steady_clock::now();
+    op->Execute(m_dbConnection);
+    delete op;
+    uint64 const timeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+    uint32 bucket = 0;
+    for (uint64 limitUs = 1000; bucket < LATENCY_BUCKETS - 1 && timeUs >= limitUs; limitUs *= 4)
+        ++bucket;
+
+    // Only this thread writes the counters
+    m_executed.store(m_executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_totalTimeUs.store(m_totalTimeUs.load(std::memory_order_relaxed) + timeUs, std::memory_order_relaxed);
+    m_latency[bucket].store(m_latency[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (timeUs > m_maxTimeUs.load(std::memory_order_relaxed))
+        m_maxTimeUs.store(uint32(std::min<uint64>(timeUs, 0xFFFFFFFF)), std::memory_order_relaxed);
 }
 
 void SqlDelayThread::ProcessRequests()
 {
     SqlOperation* s = nullptr;
     while (m_dbEngine->NextDelayedOperation(s))
-    {
-        s->Execute(m_dbConnection);
-        delete s;
-    }
+        ExecuteOperation(s);
 
     // Process any serial operations for this worker
     while (m_serialDelayQueue.next(s))
-    {
-        s->Execute(m_dbConnection);
-        delete s;
-    }
+        ExecuteOperation(s);
 }
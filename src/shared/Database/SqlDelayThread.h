@@ -23,6 +23,8 @@
 #define __SQLDELAYTHREAD_H
 
 #include "LockedQueue.h"
+#include <atomic>
+#include <condition_variable>
 
 
 class Database;
@@ -33,16 +35,38 @@ class SqlDelayThread
 {
     typedef LockedQueue<SqlOperation*, std::mutex> SqlQueue;
 
+    public:
+        // Execution time histogram: < 1ms, < 4ms, < 16ms, < 64ms, < 256ms, more
+        static uint32 const LATENCY_BUCKETS = 6;
+
+        struct Stats
+        {
+            uint64 executed;
+            uint64 totalTimeUs;
+            uint32 maxTimeUs;
+            uint64 latency[LATENCY_BUCKETS];
+            size_t serialQueueSize;
+        };
+
     private:
         SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
         Database *m_dbEngine;                               ///< Pointer to used Database engine
         SqlQueue m_serialDelayQueue;
         SqlConnection *m_dbConnection;                     ///< Pointer to DB connection
-        volatile bool m_running;
+        std::atomic<bool> m_running;
 
+        std::mutex m_wakeUpLock;
+        std::condition_variable m_wakeUp;
+        bool m_wakeUpPending;
+
+        std::atomic<uint64> m_executed;
+        std::atomic<uint64> m_totalTimeUs;
+        std::atomic<uint32> m_maxTimeUs;
+        std::atomic<uint64> m_latency[LATENCY_BUCKETS];
 
         //process all enqueued requests
         void ProcessRequests();
+        void ExecuteOperation(SqlOperation* op);
 
     public:
         SqlDelayThread(Database* db, SqlConnection* conn);
@@ -53,6 +77,10 @@ class SqlDelayThread
         void addSerialOperation(SqlOperation *op);
         bool HasAsyncQuery();
 
+        ///< Wakes the thread up if it waits for work, threadsafe
+        void WakeUp();
+        Stats GetStats();
+
         virtual void Stop();                                ///< Stop event
         void run();                                 ///< Main Thread loop
 };
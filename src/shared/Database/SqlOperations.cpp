@@ -175,7 +175,7 @@ bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, Database* databas
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx *holderEx = new SqlQueryHolderEx(this, callback, queue, serialId);
+    SqlQueryHolderEx *holderEx = new SqlQueryHolderEx(this, callback, queue, database, serialId);
 
     database->AddToSerialDelayQueue(holderEx);
     return true;
@@ -189,10 +189,10 @@ bool SqlQueryHolder::SetQuery(size_t index, char const* sql)
         return false;
     }
 
-    if(m_queries[index].first != nullptr)
+    if(m_queries[index].first != nullptr || m_statements[index].second != nullptr)
     {
         sLog.outError("Attempt assign query to holder index (" SIZEFMTD ") where other query stored (Old: [%s] New: [%s])",
-            index,m_queries[index].first,sql);
+            index,m_queries[index].first ? m_queries[index].first : "prepared statement",sql);
         return false;
     }
 
@@ -224,6 +224,35 @@ bool SqlQueryHolder::SetPQuery(size_t index, char const* format, ...)
     return SetQuery(index,szQuery);
 }
 
+bool SqlQueryHolder::SetStatement(size_t index, SqlStatement& stmt)
+{
+    std::unique_ptr<SqlStmtParameters> params(stmt.detach());
+    if(m_queries.size() <= index)
+    {
+        sLog.outError("Query index (" SIZEFMTD ") out of range (size: " SIZEFMTD ") for statement: %s", index, m_queries.size(), stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        return false;
+    }
+
+    if(m_queries[index].first != nullptr || m_statements[index].second != nullptr)
+    {
+        sLog.outError("Attempt assign statement to holder index (" SIZEFMTD ") where other query stored (New: [%s])",
+            index, stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        return false;
+    }
+
+    if(params->boundParams() != stmt.arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", params->boundParams(), stmt.arguments());
+        sLog.outError("SQL ERROR: statement: %s", stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        MANGOS_ASSERT(false);
+        return false;
+    }
+
+    /// not executed yet, just stored
+    m_statements[index] = SqlStmtPair(stmt.ID(), params.release());
+    return true;
+}
+
 QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if(index < m_queries.size())
@@ -234,6 +263,11 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
             delete [] (const_cast<char*>(m_queries[index].first));
             m_queries[index].first = nullptr;
         }
+        if(m_statements[index].second != nullptr)
+        {
+            delete m_statements[index].second;
+            m_statements[index].second = nullptr;
+        }
         /// when you get a result aways remember to delete it!
         return m_queries[index].second;
     }
@@ -254,9 +288,10 @@ SqlQueryHolder::~SqlQueryHolder()
     {
         /// if the result was never used, free the resources
         /// results used already (getresult called) are expected to be deleted
-        if(m_queries[i].first != nullptr)
+        if(m_queries[i].first != nullptr || m_statements[i].second != nullptr)
         {
             delete [] (const_cast<char*>(m_queries[i].first));
+            delete m_statements[i].second;
             if(m_queries[i].second)
             {
                 delete m_queries[i].second;
@@ -284,6 +319,21 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_statements.resize(size, SqlStmtPair(-1, nullptr));
+}
+
+void SqlQueryHolder::ExecuteQueries(SqlConnection* conn, size_t first, size_t step)
+{
+    LOCK_DB_CONN(conn);
+    for(size_t i = first; i < m_queries.size(); i += step)
+    {
+        /// execute all queries in the holder and pass the results
+        char const *sql = m_queries[i].first;
+        if (sql)
+            SetResult(i, conn->Query(sql));
+        else if (SqlStmtParameters const* params = m_statements[i].second)
+            SetResult(i, conn->QueryStmt(m_statements[i].first, *params));
+    }
 }
 
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
@@ -291,19 +341,38 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     if(!m_holder || !m_callback || !m_queue)
         return false;
 
-    LOCK_DB_CONN(conn);
-    /// we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair> &queries = m_holder->m_queries;
-    for(size_t i = 0; i < queries.size(); i++)
+    size_t parts = 1;
+    if (m_holder->m_parallel && m_db)
+        parts = std::min<size_t>(m_db->GetAsyncWorkersCount(), m_holder->m_queries.size());
+
+    if (parts > 1)
     {
-        /// execute all queries in the holder and pass the results
-        char const *sql = queries[i].first;
-        if (sql)
-            m_holder->SetResult(i, conn->Query(sql));
+        /// the writes serialized before the holder are done, the other
+        /// connections see them: give a share of the queries to every worker
+        std::shared_ptr<std::atomic<size_t>> remaining = std::make_shared<std::atomic<size_t>>(parts);
+        for (size_t part = 1; part < parts; ++part)
+            m_db->AddToDelayQueue(new SqlQueryHolderPart(m_holder, m_callback, m_queue, part, parts, remaining));
+
+        SqlQueryHolderPart(m_holder, m_callback, m_queue, 0, parts, remaining).Execute(conn);
+        return true;
     }
 
+    /// we can do this, we are friends
+    m_holder->ExecuteQueries(conn, 0, 1);
+
     /// sync with the caller thread
     m_queue->add(m_callback);
 
     return true;
 }
+
+bool SqlQueryHolderPart::Execute(SqlConnection* conn)
+{
+    m_holder->ExecuteQueries(conn, m_part, m_parts);
+
+    /// the last part done syncs with the caller thread
+    if (m_remaining->fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_queue->add(m_callback);
+
+    return true;
+}
@@ -28,6 +28,7 @@
 #include <queue>
 #include "Utilities/Callback.h"
 #include <memory>
+#include <atomic>
 
 /// ---- BASE ---
 
@@ -35,6 +36,7 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlStatement;
 
 class SqlOperation
 {
@@ -72,6 +74,7 @@ class SqlTransaction : public SqlOperation
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation* sql)   {   m_queue.push_back(sql); }
+        size_t Size() const { return m_queue.size(); }
 
         bool Execute(SqlConnection* conn);
 };
@@ -128,17 +131,27 @@ class SqlQuery : public SqlOperation
 class SqlQueryHolder
 {
     friend class SqlQueryHolderEx;
+    friend class SqlQueryHolderPart;
     private:
         typedef std::pair<char const*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        // prepared statements, at the same index as their result in m_queries
+        typedef std::pair<int, SqlStmtParameters*> SqlStmtPair;
+        std::vector<SqlStmtPair> m_statements;
 
         uint32 serialId;
+        bool m_parallel;
+
+        // runs the queries first, first + step, first + 2 * step...
+        void ExecuteQueries(SqlConnection* conn, size_t first, size_t step);
     public:
-        SqlQueryHolder(uint32 id) : serialId(id) {}
-        SqlQueryHolder() : serialId(0) {}
+        SqlQueryHolder(uint32 id) : serialId(id), m_parallel(false) {}
+        SqlQueryHolder() : serialId(0), m_parallel(false) {}
         virtual ~SqlQueryHolder();
         bool SetQuery(size_t index, char const* sql);
         bool SetPQuery(size_t index, char const* format, ...) ATTR_PRINTF(3,4);
+        // takes the parameters bound to stmt, the rows are received with the binary protocol
+        bool SetStatement(size_t index, SqlStatement& stmt);
         void SetSize(size_t size);
         size_t GetSize() const { return m_queries.size(); }
         QueryResult* GetResult(size_t index);
@@ -146,6 +159,8 @@ class SqlQueryHolder
         bool Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue);
         void DeleteAllResults();
         uint32 GetSerialId() const { return serialId; }
+        // the queries are shared between the async workers instead of running one after the other
+        void SetParallel(bool parallel) { m_parallel = parallel; }
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -154,9 +169,27 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        Database* m_db;
+    public:
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, Database* db, uint32 id)
+            : SqlOperation(id), m_holder(holder), m_callback(callback), m_queue(queue), m_db(db) {}
+        bool Execute(SqlConnection* conn);
+};
+
+/// part of a parallel holder, executed by any async worker
+class SqlQueryHolderPart : public SqlOperation
+{
+    private:
+        SqlQueryHolder* m_holder;
+        MaNGOS::IQueryCallback* m_callback;
+        SqlResultQueue* m_queue;
+        size_t m_part;
+        size_t m_parts;
+        std::shared_ptr<std::atomic<size_t>> m_remaining;   /// parts not done yet, the last one sends the callback
     public:
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, uint32 id)
-            : SqlOperation(id), m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderPart(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue,
+            size_t part, size_t parts, std::shared_ptr<std::atomic<size_t>> const& remaining)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_part(part), m_parts(parts), m_remaining(remaining) {}
         bool Execute(SqlConnection* conn);
 };
 #endif                                                      //__SQLOPERATIONS_H
@@ -84,6 +84,22 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+QueryResult* SqlStatement::Query()
+{
+    SqlStmtParameters* args = detach();
+    //verify amount of bound parameters
+    if(args->boundParams() != arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
+        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
+        MANGOS_ASSERT(false);
+        delete args;
+        return nullptr;
+    }
+
+    return m_pDB->QueryStmt(m_index, args);
+}
+
 //////////////////////////////////////////////////////////////////////////
 SqlPlainPreparedStatement::SqlPlainPreparedStatement(std::string const& fmt, SqlConnection& conn) : SqlPreparedStatement(fmt, conn)
 {
@@ -134,6 +150,14 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
+QueryResult* SqlPlainPreparedStatement::query()
+{
+    if(m_szPlainRequest.empty() || !isQuery())
+        return nullptr;
+
+    return m_pConn.Query(m_szPlainRequest.c_str());
+}
+
 void SqlPlainPreparedStatement::DataToString(SqlStmtFieldData const& data, std::ostringstream& fmt)
 {
     switch (data.type())
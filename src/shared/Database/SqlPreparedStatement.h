@@ -206,6 +206,8 @@ class SqlStatement
 
         bool Execute();
         bool DirectExecute();
+        //synchronous query, the result must be deleted by the caller
+        QueryResult* Query();
 
         //templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
@@ -272,6 +274,7 @@ class SqlStatement
     protected:
         //don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        friend class SqlQueryHolder;
         SqlStatement(SqlStatementID const& index, Database& db) : m_index(index), m_pDB(&db), m_pParams(nullptr) {}
 
     private:
@@ -325,6 +328,8 @@ class SqlPreparedStatement
 
         //execute statement w/o result set
         virtual bool execute() = 0;
+        //execute query, returns nullptr if there is no row
+        virtual QueryResult* query() = 0;
 
     protected:
         SqlPreparedStatement(std::string const& fmt, SqlConnection& conn) : m_nParams(0), m_nColumns(0), m_bIsQuery(false), m_bPrepared(false), m_szFmt(fmt), m_pConn(conn) {}
@@ -351,6 +356,7 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
         void bind(SqlStmtParameters const& holder) override;
 
         bool execute() override;
+        QueryResult* query() override;
 
     protected:
         void DataToString(SqlStmtFieldData const& data, std::ostringstream& fmt);
@@ -0,0 +1,253 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIRTYLIST_H
+#define DIRTYLIST_H
+
+#include "Common.h"
+#include "TaskScheduler.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Membership of an object in a DirtyList, embedded in the object itself.
+ * The object is in a list when its stamp equals the current generation of that list.
+ * Generations are 64 bits, unique across all lists and never reused: a stamp can only
+ * match the list that wrote it. The low bit is set while an Add publishes the position.
+ */
+struct DirtyListSlot
+{
+    std::atomic<uint64> generation{0};
+    std::atomic<uint32> position{0};                        // shard << 24 | index in shard
+};
+
+class DirtyListBase
+{
+    public:
+        static uint64 const ADDING = 1;
+
+        DirtyListBase() : m_generation(0) { Register(); }
+        virtual ~DirtyListBase()
+        {
+            std::unique_lock<std::mutex> lock(GetRegistryMutex());
+            GetRegistry().erase(m_generation);
+        }
+
+        DirtyListBase(DirtyListBase const&) = delete;
+        DirtyListBase& operator=(DirtyListBase const&) = delete;
+
+    protected:
+        // Starts a new generation, the stamps of the previous one do not match anymore
+        void Register()
+        {
+            static std::atomic<uint64> s_generation(0);
+            uint64 const generation = s_generation.fetch_add(2) + 2;  // 0 means "in no list"
+
+            std::unique_lock<std::mutex> lock(GetRegistryMutex());
+            GetRegistry().erase(m_generation);
+            GetRegistry()[generation] = this;
+            m_generation = generation;
+        }
+
+        // An object stamped by an other list (on an other map) is taken by this one: the
+        // entry is cleared in the previous list, if it still exists and is at that generation
+        static void Unlink(uint64 generation, uint32 position, void const* item)
+        {
+            std::unique_lock<std::mutex> lock(GetRegistryMutex());
+            auto itr = GetRegistry().find(generation);
+            if (itr != GetRegistry().end())
+                itr->second->ClearEntry(position, item);
+        }
+
+        virtual void ClearEntry(uint32 position, void const* item) = 0;
+
+        uint64 m_generation;
+
+    private:
+        static std::mutex& GetRegistryMutex()
+        {
+            static std::mutex s_mutex;
+            return s_mutex;
+        }
+
+        static std::unordered_map<uint64, DirtyListBase*>& GetRegistry()
+        {
+            static std::unordered_map<uint64, DirtyListBase*> s_registry;
+            return s_registry;
+        }
+};
+
+/**
+ * @brief Set of objects to process once per update, replacing std::set + mutex.
+ *
+ * Add is O(1): the stamp on the object rejects duplicates and the object is appended
+ * to the vector of the calling scheduler worker, so workers do not contend on one lock.
+ * Remove clears the entry in place. Collect gathers the entries at the barrier,
+ * Clear resets the stamps of the entries and starts a new generation.
+ *
+ * An object is in at most one list per slot: adding it to the list of an other map
+ * removes it from the previous one.
+ */
+template<class T, DirtyListSlot T::* Slot>
+class DirtyList : public DirtyListBase
+{
+    public:
+        explicit DirtyList(TaskScheduler const* scheduler) : m_scheduler(scheduler),
+            m_shardCount(scheduler ? scheduler->size() + 1 : 1), m_shards(new Shard[m_shardCount])
+        {
+        }
+
+        // Threadsafe
+        void Add(T* item)
+        {
+            DirtyListSlot& slot = item->*Slot;
+            uint64 const generation = m_generation;
+            uint64 current = slot.generation.load(std::memory_order_acquire);
+            do
+            {
+                if ((current & ~ADDING) == generation)
+                    return;
+                // An other list is publishing the position, the stamp is not ours to take yet
+                while (current & ADDING)
+                {
+                    std::this_thread::yield();
+                    current = slot.generation.load(std::memory_order_acquire);
+                    if ((current & ~ADDING) == generation)
+                        return;
+                }
+            } while (!slot.generation.compare_exchange_weak(current, generation | ADDING, std::memory_order_acq_rel));
+
+            if (current)
+                Unlink(current, slot.position.load(std::memory_order_relaxed), item);
+
+            uint32 const shardId = m_scheduler ? m_scheduler->workerId() + 1 : 0;
+            Shard& shard = m_shards[shardId];
+            {
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                MANGOS_ASSERT(shard.items.size() < 0x1000000);
+                slot.position.store(shardId << 24 | uint32(shard.items.size()), std::memory_order_relaxed);
+                shard.items.push_back(item);
+            }
+            slot.generation.store(generation, std::memory_order_release);
+        }
+
+        // Threadsafe, not while the entries returned by Collect are processed
+        void Remove(T* item)
+        {
+            DirtyListSlot& slot = item->*Slot;
+            uint64 const generation = m_generation;
+            uint64 current = slot.generation.load(std::memory_order_acquire);
+            uint32 position;
+            do
+            {
+                // A concurrent Add may not have published the position yet
+                while (current == (generation | ADDING))
+                {
+                    std::this_thread::yield();
+                    current = slot.generation.load(std::memory_order_acquire);
+                }
+                if (current != generation)
+                    return;
+                position = slot.position.load(std::memory_order_relaxed);
+            } while (!slot.generation.compare_exchange_weak(current, 0, std::memory_order_acq_rel));
+
+            ClearEntry(position, item);
+        }
+
+        bool Contains(T const* item) const { return ((item->*Slot).generation.load(std::memory_order_acquire) & ~ADDING) == m_generation; }
+
+        // Number of entries, including removed ones
+        size_t size() const
+        {
+            size_t count = 0;
+            for (uint32 i = 0; i < m_shardCount; ++i)
+            {
+                std::unique_lock<std::mutex> lock(m_shards[i].mutex);
+                count += m_shards[i].items.size();
+            }
+            return count;
+        }
+
+        // Not threadsafe: call at the barrier, once nothing is added anymore to this list
+        std::vector<T*> const& Collect()
+        {
+            m_collected.clear();
+            for (uint32 i = 0; i < m_shardCount; ++i)
+            {
+                std::unique_lock<std::mutex> lock(m_shards[i].mutex);
+                for (T* item : m_shards[i].items)
+                    if (item)
+                        m_collected.push_back(item);
+            }
+            return m_collected;
+        }
+
+        // Not threadsafe: empties the list, keeping the allocated memory
+        void Clear()
+        {
+            for (uint32 i = 0; i < m_shardCount; ++i)
+            {
+                std::unique_lock<std::mutex> lock(m_shards[i].mutex);
+                for (T* item : m_shards[i].items)
+                {
+                    if (!item)
+                        continue;
+                    uint64 generation = m_generation;
+                    (item->*Slot).generation.compare_exchange_strong(generation, 0, std::memory_order_acq_rel);
+                }
+            }
+
+            Register();
+
+            for (uint32 i = 0; i < m_shardCount; ++i)
+            {
+                std::unique_lock<std::mutex> lock(m_shards[i].mutex);
+                m_shards[i].items.clear();
+            }
+        }
+
+    private:
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            std::vector<T*> items;
+        };
+
+        // Clears the entry only if it is still the one of item
+        void ClearEntry(uint32 position, void const* item) override
+        {
+            uint32 const shardId = position >> 24;
+            uint32 const index = position & 0xFFFFFF;
+            if (shardId >= m_shardCount)
+                return;
+
+            Shard& shard = m_shards[shardId];
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            if (index < shard.items.size() && shard.items[index] == item)
+                shard.items[index] = nullptr;
+        }
+
+        TaskScheduler const* m_scheduler;
+        uint32 m_shardCount;
+        std::unique_ptr<Shard[]> m_shards;
+        std::vector<T*> m_collected;
+};
+
+#endif
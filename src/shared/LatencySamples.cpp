@@ -0,0 +1,49 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LatencySamples.h"
+#include <algorithm>
+
+void LatencySamples::Record(uint32 ms)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_samples[m_next] = ms;
+    m_next = (m_next + 1) % m_samples.size();
+    ++m_count;
+}
+
+LatencySamples::Percentiles LatencySamples::GetPercentiles() const
+{
+    std::vector<uint32> samples;
+    Percentiles result = {};
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        result.count = m_count;
+        size_t const kept = std::min<uint64>(m_count, m_samples.size());
+        samples.assign(m_samples.begin(), m_samples.begin() + kept);
+    }
+
+    if (samples.empty())
+        return result;
+
+    std::sort(samples.begin(), samples.end());
+    size_t const last = samples.size() - 1;
+    result.p50 = samples[last * 50 / 100];
+    result.p90 = samples[last * 90 / 100];
+    result.p99 = samples[last * 99 / 100];
+    result.max = samples[last];
+    return result;
+}
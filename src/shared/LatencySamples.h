@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LATENCYSAMPLES_H
+#define LATENCYSAMPLES_H
+
+#include "Common.h"
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Keeps the last durations recorded, to report their percentiles.
+ *
+ * The samples are kept in a ring, so the percentiles follow the recent load
+ * (a login storm after a restart) rather than the whole uptime. Record() is
+ * threadsafe and cheap, GetPercentiles() sorts a copy of the ring.
+ */
+class LatencySamples
+{
+    public:
+        explicit LatencySamples(size_t capacity = 1024) : m_samples(capacity), m_next(0), m_count(0) {}
+
+        void Record(uint32 ms);
+
+        struct Percentiles
+        {
+            uint64 count;                                   // samples since startup
+            uint32 p50;
+            uint32 p90;
+            uint32 p99;
+            uint32 max;                                     // of the samples kept
+        };
+        Percentiles GetPercentiles() const;
+
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<uint32> m_samples;
+        size_t m_next;
+        uint64 m_count;
+};
+
+#endif
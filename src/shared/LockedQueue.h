@@ -135,5 +135,12 @@ template <class T, class LockType, typename StorageType=std::deque<T> >
             std::unique_lock<LockType> g(this->_lock);
             return _queue.empty();
         }
+
+        //! Number of queued items, with locks held
+        size_t size()
+        {
+            std::unique_lock<LockType> g(this->_lock);
+            return _queue.size();
+        }
 };
 #endif
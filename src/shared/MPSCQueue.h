@@ -0,0 +1,165 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @brief Bounded lock-free queue, many producers and one consumer at a time.
+ *
+ * Ring of cells stamped with a sequence number (D. Vyukov's bounded queue):
+ * a producer claims a slot with one CAS on the tail, the consumer claims one or
+ * several ready slots with one CAS on the head. The head is a CAS too so that an
+ * occasional second consumer (clearing the queue from an other thread) stays safe.
+ * add() fails instead of blocking when the queue is full.
+ */
+template<class T>
+class BoundedMPSCQueue
+{
+    public:
+        // capacity is rounded up to a power of 2
+        explicit BoundedMPSCQueue(size_t capacity = 1024)
+        {
+            setCapacity(capacity);
+        }
+
+        //! Not threadsafe, drops the queued items: call before the queue is used.
+        void setCapacity(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+            m_mask = size - 1;
+            m_cells.reset(new Cell[size]);
+            for (size_t i = 0; i < size; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            m_head.store(0, std::memory_order_relaxed);
+            m_tail.store(0, std::memory_order_relaxed);
+        }
+
+        BoundedMPSCQueue(BoundedMPSCQueue const&) = delete;
+        BoundedMPSCQueue& operator=(BoundedMPSCQueue const&) = delete;
+
+        //! Adds an item to the queue, returns false if the queue is full.
+        bool add(T const& item)
+        {
+            size_t pos = m_tail.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;)
+            {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t dif = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+                if (dif == 0)
+                {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = m_tail.load(std::memory_order_relaxed);
+            }
+            cell->data = item;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Gets the next item in the queue, if any.
+        bool next(T& result)
+        {
+            AcceptAll check;
+            return nextBatch(&result, 1, check) == 1;
+        }
+
+        //! Gets the next item if check.Process() accepts it.
+        template<class Checker>
+        bool next(T& result, Checker& check)
+        {
+            return nextBatch(&result, 1, check) == 1;
+        }
+
+        /**
+         * @brief nextBatch dequeues up to maxCount items in order, stopping at the
+         * first item check.Process() refuses (left in the queue).
+         * @return number of items written to result
+         */
+        template<class Checker>
+        size_t nextBatch(T* result, size_t maxCount, Checker& check)
+        {
+            size_t pos = m_head.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                size_t count = 0;
+                while (count < maxCount)
+                {
+                    Cell& cell = m_cells[(pos + count) & m_mask];
+                    if (cell.sequence.load(std::memory_order_acquire) != pos + count + 1)
+                        break;
+                    result[count] = cell.data;
+                    if (!check.Process(result[count]))
+                        break;
+                    ++count;
+                }
+                if (!count)
+                    return 0;
+
+                if (m_head.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+                {
+                    for (size_t i = 0; i < count; ++i)
+                        m_cells[(pos + i) & m_mask].sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+                    return count;
+                }
+                // An other consumer took them, pos was reloaded
+            }
+        }
+
+        //! Approximate number of queued items.
+        size_t size() const
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t head = m_head.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        size_t capacity() const { return m_mask + 1; }
+
+    private:
+        struct AcceptAll
+        {
+            bool Process(T const&) { return true; }
+        };
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        size_t m_mask;
+        // Producers and consumer write on different cache lines
+        char m_padding1[64];
+        std::atomic<size_t> m_tail;
+        char m_padding2[64 - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> m_head;
+};
+
+#endif
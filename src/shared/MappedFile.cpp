@@ -0,0 +1,114 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::Open(char const* filename)
+{
+    Close();
+    return Map(filename) || Read(filename);
+}
+
+bool MappedFile::Map(char const* filename)
+{
+#ifndef WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // Private and never written: the pages stay those of the page cache
+    void* address = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<unsigned char*>(address);
+    m_size = st.st_size;
+    m_mapped = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MappedFile::Read(char const* filename)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0)
+    {
+        fclose(file);
+        return false;
+    }
+
+    m_data = new unsigned char[size];
+    m_size = size;
+    bool const read = fread(m_data, 1, m_size, file) == m_size;
+    fclose(file);
+
+    if (!read)
+        Close();
+    return read;
+}
+
+void MappedFile::Close()
+{
+#ifndef WIN32
+    if (m_mapped)
+        munmap(m_data, m_size);
+    else
+#endif
+        delete[] m_data;
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
+
+void MappedFile::ReleasePages(size_t size)
+{
+#ifndef WIN32
+    if (!m_mapped)
+        return;
+
+    size_t const pageSize = size_t(sysconf(_SC_PAGESIZE));
+    size_t const end = std::min(size, m_size) / pageSize * pageSize;
+    if (end)
+        madvise(m_data, end, MADV_DONTNEED);
+#endif
+}
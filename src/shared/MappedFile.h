@@ -0,0 +1,61 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "Platform/Define.h"
+#include <cstddef>
+
+/**
+ * @brief Read-only image of a whole file.
+ *
+ * The file is mapped when the system allows it: the pages are those of the page cache,
+ * read from the disk when first used and shared by every process mapping the same file.
+ * Elsewhere (Windows, or when the mapping fails) the file is read in memory.
+ */
+class MappedFile
+{
+    public:
+        MappedFile() : m_data(nullptr), m_size(0), m_mapped(false) {}
+        ~MappedFile() { Close(); }
+
+        // Fails for a missing or empty file
+        bool Open(char const* filename);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        bool IsMapped() const { return m_mapped; }
+        unsigned char const* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+        // Lets the system drop the mapped pages of the first size bytes, read again from the file if used
+        void ReleasePages(size_t size);
+
+    private:
+        MappedFile(MappedFile const&);
+        MappedFile& operator=(MappedFile const&);
+
+        bool Map(char const* filename);
+        bool Read(char const* filename);
+
+        unsigned char* m_data;
+        size_t m_size;
+        bool m_mapped;
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PacketBufferPool.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+    size_t const CLASS_COUNT = 6;
+    size_t const ClassSizes[CLASS_COUNT]       = {  64, 256, 1024, 4096, 16384, 65536 };
+    // Free blocks kept by each thread, about 256KB for the biggest classes
+    size_t const ThreadCacheLimits[CLASS_COUNT] = { 256, 256,  128,   64,    16,     4 };
+    size_t const DepotLimits[CLASS_COUNT]       = { 4096, 4096, 2048, 1024,  256,    64 };
+
+    int GetSizeClass(size_t size)
+    {
+        for (size_t i = 0; i < CLASS_COUNT; ++i)
+            if (size <= ClassSizes[i])
+                return int(i);
+        return -1;
+    }
+
+    // Only written by the owning thread, read by GetStats
+    struct Counters
+    {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> heapAllocations{0};
+        std::atomic<uint64_t> heapFrees{0};
+        std::atomic<uint64_t> depotTransfers{0};
+    };
+
+    inline void Increment(std::atomic<uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    struct ThreadCache
+    {
+        ThreadCache()
+        {
+            for (size_t i = 0; i < CLASS_COUNT; ++i)
+                blocks[i].reserve(ThreadCacheLimits[i]);
+        }
+
+        std::vector<void*> blocks[CLASS_COUNT];
+        Counters counters;
+    };
+
+    struct Depot
+    {
+        Depot()
+        {
+            for (size_t i = 0; i < CLASS_COUNT; ++i)
+                blocks[i].reserve(DepotLimits[i]);
+        }
+
+        std::mutex mutex;
+        std::vector<void*> blocks[CLASS_COUNT];
+        std::vector<ThreadCache*> caches;
+        PacketBufferPool::Stats retired = {};               // threads that exited, or without cache
+    };
+
+    // Never destroyed: packets may still be freed by static destructors
+    Depot& GetDepot()
+    {
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    void ReleaseThreadCache(ThreadCache* cache)
+    {
+        Depot& depot = GetDepot();
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        for (size_t i = 0; i < CLASS_COUNT; ++i)
+        {
+            for (void* block : cache->blocks[i])
+            {
+                if (depot.blocks[i].size() < DepotLimits[i])
+                    depot.blocks[i].push_back(block);
+                else
+                {
+                    ::operator delete(block);
+                    ++depot.retired.heapFrees;
+                }
+            }
+        }
+        depot.retired.allocations += cache->counters.allocations;
+        depot.retired.heapAllocations += cache->counters.heapAllocations;
+        depot.retired.heapFrees += cache->counters.heapFrees;
+        depot.retired.depotTransfers += cache->counters.depotTransfers;
+        depot.caches.erase(std::remove(depot.caches.begin(), depot.caches.end(), cache), depot.caches.end());
+        delete cache;
+    }
+
+    thread_local ThreadCache* t_cache = nullptr;
+    thread_local bool t_exited = false;
+
+    struct ThreadCacheGuard
+    {
+        bool used = false;
+        ~ThreadCacheGuard()
+        {
+            t_exited = true;
+            if (t_cache)
+                ReleaseThreadCache(t_cache);
+            t_cache = nullptr;
+        }
+    };
+    thread_local ThreadCacheGuard t_guard;
+
+    ThreadCache* GetThreadCache()
+    {
+        if (t_cache || t_exited)
+            return t_cache;
+
+        t_guard.used = true;                                // registers the guard destructor
+        t_cache = new ThreadCache();
+        Depot& depot = GetDepot();
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        depot.caches.push_back(t_cache);
+        return t_cache;
+    }
+
+    // Takes half a cache worth of blocks from the depot
+    void Refill(ThreadCache* cache, int sizeClass)
+    {
+        Depot& depot = GetDepot();
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        std::vector<void*>& from = depot.blocks[sizeClass];
+        size_t count = std::min(from.size(), ThreadCacheLimits[sizeClass] / 2);
+        if (!count)
+            return;
+        cache->blocks[sizeClass].insert(cache->blocks[sizeClass].end(), from.end() - count, from.end());
+        from.resize(from.size() - count);
+        Increment(cache->counters.depotTransfers);
+    }
+
+    // Gives half of the cache to the depot, to the heap what does not fit
+    void Flush(ThreadCache* cache, int sizeClass)
+    {
+        std::vector<void*>& from = cache->blocks[sizeClass];
+        size_t count = from.size() / 2;
+        {
+            Depot& depot = GetDepot();
+            std::unique_lock<std::mutex> lock(depot.mutex);
+            std::vector<void*>& to = depot.blocks[sizeClass];
+            while (count && to.size() < DepotLimits[sizeClass])
+            {
+                to.push_back(from.back());
+                from.pop_back();
+                --count;
+            }
+        }
+        Increment(cache->counters.depotTransfers);
+        for (; count; --count)
+        {
+            ::operator delete(from.back());
+            from.pop_back();
+            Increment(cache->counters.heapFrees);
+        }
+    }
+
+    void* AllocateFromHeap(size_t size, ThreadCache* cache)
+    {
+        if (cache)
+            Increment(cache->counters.heapAllocations);
+        else
+        {
+            Depot& depot = GetDepot();
+            std::unique_lock<std::mutex> lock(depot.mutex);
+            ++depot.retired.allocations;
+            ++depot.retired.heapAllocations;
+        }
+        return ::operator new(size);
+    }
+
+    void FreeToHeap(void* block, ThreadCache* cache)
+    {
+        ::operator delete(block);
+        if (cache)
+            Increment(cache->counters.heapFrees);
+        else
+        {
+            Depot& depot = GetDepot();
+            std::unique_lock<std::mutex> lock(depot.mutex);
+            ++depot.retired.heapFrees;
+        }
+    }
+}
+
+void* PacketBufferPool::Allocate(size_t size)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (cache)
+        Increment(cache->counters.allocations);
+
+    int sizeClass = GetSizeClass(size);
+    if (sizeClass < 0)
+        return AllocateFromHeap(size, cache);
+
+    if (!cache)
+        return AllocateFromHeap(ClassSizes[sizeClass], cache);
+
+    std::vector<void*>& blocks = cache->blocks[sizeClass];
+    if (blocks.empty())
+        Refill(cache, sizeClass);
+    if (blocks.empty())
+        return AllocateFromHeap(ClassSizes[sizeClass], cache);
+
+    void* block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+
+void PacketBufferPool::Deallocate(void* block, size_t size)
+{
+    if (!block)
+        return;
+
+    ThreadCache* cache = GetThreadCache();
+    int sizeClass = GetSizeClass(size);
+    if (sizeClass < 0)
+    {
+        FreeToHeap(block, cache);
+        return;
+    }
+
+    if (!cache)
+    {
+        Depot& depot = GetDepot();
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        if (depot.blocks[sizeClass].size() < DepotLimits[sizeClass])
+        {
+            depot.blocks[sizeClass].push_back(block);
+            return;
+        }
+        lock.unlock();
+        FreeToHeap(block, cache);
+        return;
+    }
+
+    std::vector<void*>& blocks = cache->blocks[sizeClass];
+    if (blocks.size() >= ThreadCacheLimits[sizeClass])
+        Flush(cache, sizeClass);
+    blocks.push_back(block);
+}
+
+PacketBufferPool::Stats PacketBufferPool::GetStats()
+{
+    Depot& depot = GetDepot();
+    std::unique_lock<std::mutex> lock(depot.mutex);
+    Stats stats = depot.retired;
+    for (ThreadCache const* cache : depot.caches)
+    {
+        stats.allocations += cache->counters.allocations.load(std::memory_order_relaxed);
+        stats.heapAllocations += cache->counters.heapAllocations.load(std::memory_order_relaxed);
+        stats.heapFrees += cache->counters.heapFrees.load(std::memory_order_relaxed);
+        stats.depotTransfers += cache->counters.depotTransfers.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
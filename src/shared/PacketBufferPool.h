@@ -0,0 +1,66 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PACKETBUFFERPOOL_H
+#define PACKETBUFFERPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+ * @brief Size-classed memory pool for packet storage (ByteBuffer, WorldPacket).
+ *
+ * Blocks are rounded up to a size class (64B to 64KB) and recycled through a small
+ * free list per thread, so building and sending a packet does not reach the heap
+ * once the server runs. When a thread frees more blocks than it allocates (packets
+ * built by the network threads and deleted by the map threads), the surplus goes to
+ * a shared depot where the allocating threads take it back, a batch at a time.
+ * Blocks larger than the biggest class come from the heap.
+ */
+namespace PacketBufferPool
+{
+    void* Allocate(size_t size);
+    void Deallocate(void* block, size_t size);
+
+    struct Stats
+    {
+        uint64_t allocations;                               // all blocks handed out
+        uint64_t heapAllocations;                           // blocks that had to come from the heap
+        uint64_t heapFrees;                                 // blocks returned to the heap
+        uint64_t depotTransfers;                            // batches exchanged with the shared depot
+    };
+    // Totals since startup, approximate while other threads run
+    Stats GetStats();
+}
+
+// std::allocator replacement for the storage of ByteBuffer
+template<class T>
+struct PacketBufferAllocator
+{
+    typedef T value_type;
+
+    PacketBufferAllocator() = default;
+    template<class U> PacketBufferAllocator(PacketBufferAllocator<U> const&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) { PacketBufferPool::Deallocate(p, n * sizeof(T)); }
+
+    template<class U> bool operator==(PacketBufferAllocator<U> const&) const { return true; }
+    template<class U> bool operator!=(PacketBufferAllocator<U> const&) const { return false; }
+};
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "StartupLoader.h"
+#include "Database/Database.h"
+#include "Errors.h"
+#include "Log.h"
+#include "ProgressBar.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+
+#ifndef DO_POSTGRESQL
+using StartupLoaderWorker = ThreadPool::MySQL<>;
+#else
+using StartupLoaderWorker = ThreadPool::SingleQueue;
+#endif
+
+void StartupLoader::Add(char const* name, Loader loader, std::initializer_list<char const*> after)
+{
+    Task task;
+    task.name = name;
+    task.loader = std::move(loader);
+    task.waitingFor = 0;
+    task.started = false;
+    task.thread = 0;
+    task.start = 0;
+    task.duration = 0;
+    task.rows = 0;
+
+    size_t const index = m_tasks.size();
+    for (char const* dependency : after)
+    {
+        Task* before = FindTask(dependency);
+        MANGOS_ASSERT(before);
+        before->dependents.push_back(index);
+        ++task.waitingFor;
+    }
+    m_tasks.push_back(std::move(task));
+}
+
+StartupLoader::Task* StartupLoader::FindTask(char const* name)
+{
+    for (Task& task : m_tasks)
+        if (task.name == name)
+            return &task;
+    return nullptr;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    m_startTime = WorldTimer::getMSTime();
+    m_threads = std::max<uint32>(1, std::min<uint32>(threads, m_tasks.size()));
+
+    if (m_threads == 1)
+        RunLoaders();
+    else
+    {
+        // The bars of the loaders running together would overwrite each other
+        bool const showBars = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+        {
+            ThreadPool pool(m_threads);
+            pool.start<StartupLoaderWorker>();
+            ThreadPool::workload_t workload(m_threads, [this]() { RunLoaders(); });
+            pool.processWorkload(std::move(workload)).wait();
+        }
+        BarGoLink::SetOutputState(showBars);
+    }
+
+    m_duration = WorldTimer::getMSTimeDiffToNow(m_startTime);
+}
+
+void StartupLoader::RunLoaders()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint32 const thread = m_threadCount++;
+
+    while (m_done < m_tasks.size())
+    {
+        Task* ready = nullptr;
+        for (size_t i = m_next; i < m_tasks.size(); ++i)
+        {
+            Task& task = m_tasks[i];
+            if (!task.started && !task.waitingFor)
+            {
+                ready = &task;
+                break;
+            }
+        }
+
+        if (!ready)
+        {
+            m_taskDone.wait(lock);
+            continue;
+        }
+
+        ready->started = true;
+        while (m_next < m_tasks.size() && m_tasks[m_next].started)
+            ++m_next;
+
+        lock.unlock();
+        RunTask(*ready, thread);
+        lock.lock();
+
+        for (size_t dependent : ready->dependents)
+            --m_tasks[dependent].waitingFor;
+        ++m_done;
+        m_taskDone.notify_all();
+    }
+}
+
+void StartupLoader::RunTask(Task& task, uint32 thread)
+{
+    uint64 const rows = Database::GetThreadFetchedRows();
+    uint32 const start = WorldTimer::getMSTime();
+
+    task.loader();
+
+    task.thread = thread;
+    task.start = WorldTimer::getMSTimeDiff(m_startTime, start);
+    task.duration = WorldTimer::getMSTimeDiffToNow(start);
+    task.rows = uint32(Database::GetThreadFetchedRows() - rows);
+}
+
+void StartupLoader::PrintTimeline() const
+{
+    if (m_tasks.empty())
+        return;
+
+    uint32 busy = 0;
+    for (Task const& task : m_tasks)
+        busy += task.duration;
+
+    sLog.outString("Startup timeline: %u loaders on %u threads, %u ms (%u ms of loading)", uint32(m_tasks.size()), m_threads, m_duration, busy);
+    sLog.outString("   start    time  thread        rows  loader");
+    for (Task const& task : m_tasks)
+        sLog.outString("%8u%8u%8u%12u  %s", task.start, task.duration, task.thread, task.rows, task.name.c_str());
+    sLog.outString();
+}
@@ -0,0 +1,86 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STARTUPLOADER_H
+#define STARTUPLOADER_H
+
+#include "Common.h"
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Runs the loaders of the server startup as a dependency graph.
+ *
+ * Each loader names the loaders it must run after. Run() starts a loader as soon
+ * as the loaders it depends on are done, on up to the given number of threads, so
+ * loaders of independent tables read the database at the same time (each query
+ * takes one of the sync connections of the database, see Database.Connections).
+ * The ready loaders start in the order they were added: with one thread, they run
+ * exactly in that order.
+ *
+ * The loaders running together must not write the same data, and must not read
+ * data an other one writes, unless one depends on the other.
+ */
+class StartupLoader
+{
+    public:
+        typedef std::function<void()> Loader;
+
+        StartupLoader() : m_startTime(0), m_threads(0), m_duration(0), m_next(0), m_done(0), m_threadCount(0) {}
+
+        // The loaders in after must have been added before
+        void Add(char const* name, Loader loader, std::initializer_list<char const*> after = {});
+
+        // Returns when all the loaders are done
+        void Run(uint32 threads);
+
+        // Start, wall time and rows read by each loader
+        void PrintTimeline() const;
+
+    private:
+        struct Task
+        {
+            std::string name;
+            Loader loader;
+            std::vector<size_t> dependents;                 // index in m_tasks
+            uint32 waitingFor;                              // dependencies not done yet
+            bool started;
+            uint32 thread;
+            uint32 start;                                   // ms since Run()
+            uint32 duration;
+            uint32 rows;                                    // returned by the sync queries of the loader
+        };
+
+        Task* FindTask(char const* name);
+        void RunLoaders();
+        void RunTask(Task& task, uint32 thread);
+
+        std::vector<Task> m_tasks;
+        uint32 m_startTime;
+        uint32 m_threads;
+        uint32 m_duration;
+
+        std::mutex m_mutex;
+        std::condition_variable m_taskDone;
+        size_t m_next;                                      // first task maybe not started
+        size_t m_done;
+        uint32 m_threadCount;
+};
+
+#endif
@@ -0,0 +1,302 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TaskScheduler.h"
+
+namespace
+{
+    thread_local TaskScheduler const* t_scheduler = nullptr;
+    thread_local int t_workerId = -1;
+    thread_local TaskScheduler::TaskGroup* t_currentGroup = nullptr;
+}
+
+TaskScheduler::TaskGroup::TaskGroup() : m_pending(0), m_waiters(0), m_spawned(0), m_parent(t_currentGroup)
+{
+}
+
+TaskScheduler::TaskGroup::~TaskGroup()
+{
+    if (m_scheduler && !done())
+    {
+        try
+        {
+            m_scheduler->wait(*this);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+void TaskScheduler::TaskGroup::then(Callable continuation)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Every task already finished, nothing will trigger the continuation
+    if (m_scheduler && done())
+    {
+        lock.unlock();
+        m_scheduler->spawn(*this, std::move(continuation));
+        return;
+    }
+    m_continuation = std::move(continuation);
+}
+
+bool TaskScheduler::TaskGroup::isDescendantOf(TaskGroup const* group) const
+{
+    for (TaskGroup const* g = this; g; g = g->m_parent)
+        if (g == group)
+            return true;
+    return false;
+}
+
+TaskScheduler::TaskScheduler(size_t numThreads, Callable threadInit, Callable threadExit) :
+    m_threadInit(std::move(threadInit)), m_threadExit(std::move(threadExit)), m_queued(0), m_sleeping(0), m_terminating(false), m_executed(0), m_stolen(0)
+{
+    if (!numThreads)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // All deques must exist before the first worker may try to steal
+    m_workers.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i)
+        m_workers.emplace_back(new Worker());
+    for (size_t i = 0; i < numThreads; ++i)
+        m_workers[i]->thread = std::thread([this, i]() { loop(i); });
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_terminating = true;
+        m_wakeUp.notify_all();
+    }
+    for (auto& worker : m_workers)
+        worker->thread.join();
+}
+
+int TaskScheduler::workerId() const
+{
+    return t_scheduler == this ? t_workerId : -1;
+}
+
+void TaskScheduler::spawn(TaskGroup& group, Callable task)
+{
+    group.m_scheduler = this;
+    group.m_pending.fetch_add(1, std::memory_order_acq_rel);
+
+    int id = workerId();
+    if (id >= 0)
+    {
+        Worker& worker = *m_workers[id];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back({ std::move(task), &group });
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(m_injectedMutex);
+        m_injected.push_back({ std::move(task), &group });
+    }
+
+    ++m_queued;
+    if (m_sleeping > 0)
+    {
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.notify_one();
+    }
+
+    notifySpawned(group);
+}
+
+// Wakes up the threads waiting for the group or one of its parents, they can run the new task
+void TaskScheduler::notifySpawned(TaskGroup& group)
+{
+    for (TaskGroup* g = &group; g; g = g->m_parent)
+    {
+        g->m_spawned.fetch_add(1);
+        if (g->m_waiters.load() > 0)
+        {
+            std::unique_lock<std::mutex> lock(g->m_mutex);
+            g->m_done.notify_all();
+        }
+    }
+}
+
+void TaskScheduler::wait(TaskGroup& group)
+{
+    group.m_waiters.fetch_add(1);
+    while (!group.done())
+    {
+        unsigned const spawned = group.m_spawned.load();
+        if (runPendingTask(group))
+            continue;
+
+        // Remaining tasks are running on other threads: sleep until the last one is
+        // done, or until one of them spawns a child task we can help with
+        std::unique_lock<std::mutex> lock(group.m_mutex);
+        group.m_done.wait(lock, [&group, spawned]() { return group.done() || group.m_spawned.load() != spawned; });
+    }
+    group.m_waiters.fetch_sub(1);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(group.m_mutex);
+        std::swap(error, group.m_error);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+bool TaskScheduler::runPendingTask(TaskGroup& group)
+{
+    Task task;
+    if (!findTask(workerId(), task, &group))
+        return false;
+    execute(task);
+    return true;
+}
+
+void TaskScheduler::loop(int id)
+{
+    t_scheduler = this;
+    t_workerId = id;
+    if (m_threadInit)
+        m_threadInit();
+
+    while (!m_terminating)
+    {
+        Task task;
+        if (findTask(id, task, nullptr))
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        ++m_sleeping;
+        m_wakeUp.wait(lock, [this]() { return m_terminating || m_queued > 0; });
+        --m_sleeping;
+    }
+
+    if (m_threadExit)
+        m_threadExit();
+}
+
+void TaskScheduler::execute(Task& task)
+{
+    TaskGroup* previous = t_currentGroup;
+    t_currentGroup = task.group;
+    try
+    {
+        task.function();
+    }
+    catch (...)
+    {
+        std::unique_lock<std::mutex> lock(task.group->m_mutex);
+        if (!task.group->m_error)
+            task.group->m_error = std::current_exception();
+    }
+    t_currentGroup = previous;
+    ++m_executed;
+    finish(*task.group);
+}
+
+void TaskScheduler::finish(TaskGroup& group)
+{
+    std::unique_lock<std::mutex> lock(group.m_mutex);
+    if (group.m_continuation && group.m_pending.load(std::memory_order_acquire) == 1)
+    {
+        Callable continuation = std::move(group.m_continuation);
+        group.m_continuation = Callable();
+        lock.unlock();
+        spawn(group, std::move(continuation));
+        lock.lock();
+    }
+    if (group.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        group.m_done.notify_all();
+}
+
+static bool Matches(TaskScheduler::TaskGroup const* taskGroup, TaskScheduler::TaskGroup const* group)
+{
+    return !group || taskGroup->isDescendantOf(group);
+}
+
+bool TaskScheduler::popOwn(int id, Task& task, TaskGroup const* group)
+{
+    Worker& worker = *m_workers[id];
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    for (auto it = worker.tasks.rbegin(); it != worker.tasks.rend(); ++it)
+    {
+        if (!Matches(it->group, group))
+            continue;
+        task = std::move(*it);
+        worker.tasks.erase(std::next(it).base());
+        --m_queued;
+        return true;
+    }
+    return false;
+}
+
+bool TaskScheduler::popInjected(Task& task, TaskGroup const* group)
+{
+    std::unique_lock<std::mutex> lock(m_injectedMutex);
+    for (auto it = m_injected.begin(); it != m_injected.end(); ++it)
+    {
+        if (!Matches(it->group, group))
+            continue;
+        task = std::move(*it);
+        m_injected.erase(it);
+        --m_queued;
+        return true;
+    }
+    return false;
+}
+
+bool TaskScheduler::steal(int thief, Task& task, TaskGroup const* group)
+{
+    int const count = m_workers.size();
+    int const first = thief >= 0 ? thief + 1 : 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int victim = (first + i) % count;
+        if (victim == thief)
+            continue;
+
+        Worker& worker = *m_workers[victim];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        for (auto it = worker.tasks.begin(); it != worker.tasks.end(); ++it)
+        {
+            if (!Matches(it->group, group))
+                continue;
+            task = std::move(*it);
+            worker.tasks.erase(it);
+            --m_queued;
+            ++m_stolen;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::findTask(int id, Task& task, TaskGroup const* group)
+{
+    if (m_queued <= 0)
+        return false;
+    if (id >= 0 && popOwn(id, task, group))
+        return true;
+    if (popInjected(task, group))
+        return true;
+    return steal(id, task, group);
+}
@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+/**
+ * @brief Work-stealing task scheduler shared by the map and world updates.
+ *
+ * Every worker owns a deque: tasks spawned from a worker are pushed to the back
+ * of its own deque and popped back (LIFO) by that worker, idle workers steal from
+ * the front of the other deques. Tasks spawned from a non worker thread (the world
+ * thread) go to a shared injection queue.
+ *
+ * Tasks are always spawned into a TaskGroup. Waiting for a group never blocks a
+ * thread while tasks of that group (or of a group created from one of its tasks)
+ * are still queued: the waiting thread executes them itself. Tasks of unrelated
+ * groups are never run by a waiting thread, so a map update waiting for its cells
+ * will not start an other map update on its stack.
+ */
+class TaskScheduler
+{
+public:
+    using Callable = std::function<void()>;
+
+    class TaskGroup
+    {
+        friend class TaskScheduler;
+    public:
+        /**
+         * @brief A group created from inside a running task is a child of the group
+         * of that task, and can be helped by threads waiting for the parent group.
+         */
+        TaskGroup();
+        ~TaskGroup();
+
+        TaskGroup(TaskGroup const&) = delete;
+        TaskGroup& operator=(TaskGroup const&) = delete;
+
+        /**
+         * @brief then sets a task spawned in this group once all its current tasks are done
+         * (immediately if they already are).
+         * Waiting for the group also waits for the continuation.
+         */
+        void then(Callable continuation);
+
+        /**
+         * @brief done
+         * @return true when no task of this group is queued or running
+         */
+        bool done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+        bool isDescendantOf(TaskGroup const* group) const;
+
+    private:
+        std::atomic<int> m_pending;
+        std::atomic<int> m_waiters;
+        std::atomic<unsigned> m_spawned;                    // tasks spawned in this group or a child group
+        TaskGroup* m_parent;
+        TaskScheduler* m_scheduler = nullptr;
+        Callable m_continuation;
+        std::exception_ptr m_error;
+        std::mutex m_mutex;
+        std::condition_variable m_done;
+    };
+
+    /**
+     * @brief TaskScheduler spawns the workers immediately.
+     * @param numThreads number of workers, 0 for one per hardware thread.
+     * @param threadInit called by each worker before its first task, threadExit after its last one
+     */
+    explicit TaskScheduler(size_t numThreads, Callable threadInit = Callable(), Callable threadExit = Callable());
+    ~TaskScheduler();
+
+    TaskScheduler(TaskScheduler const&) = delete;
+    TaskScheduler& operator=(TaskScheduler const&) = delete;
+
+    /**
+     * @brief spawn queues a task in the group. Threadsafe, can be called from a task.
+     */
+    void spawn(TaskGroup& group, Callable task);
+
+    /**
+     * @brief wait returns once every task of the group is done, running queued tasks
+     * of the group meanwhile. Rethrows the first exception thrown by a task of the group.
+     */
+    void wait(TaskGroup& group);
+
+    /**
+     * @brief runPendingTask executes on the calling thread one queued task of the group
+     * or of one of its child groups.
+     * @return false if no such task is queued
+     */
+    bool runPendingTask(TaskGroup& group);
+
+    /**
+     * @brief size
+     * @return the number of workers, the thread calling wait() is not counted
+     */
+    size_t size() const { return m_workers.size(); }
+
+    /**
+     * @brief workerId
+     * @return the index of the calling worker of this scheduler, or -1
+     */
+    int workerId() const;
+
+    uint64_t executedCount() const { return m_executed.load(std::memory_order_relaxed); }
+    uint64_t stolenCount() const { return m_stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct Task
+    {
+        Callable function;
+        TaskGroup* group;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void loop(int id);
+    void execute(Task& task);
+    void notifySpawned(TaskGroup& group);
+    void finish(TaskGroup& group);
+    bool popOwn(int id, Task& task, TaskGroup const* group);
+    bool popInjected(Task& task, TaskGroup const* group);
+    bool steal(int thief, Task& task, TaskGroup const* group);
+    bool findTask(int id, Task& task, TaskGroup const* group);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    Callable m_threadInit;
+    Callable m_threadExit;
+    std::mutex m_injectedMutex;
+    std::deque<Task> m_injected;
+
+    // Idle workers sleep until a task is queued
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<int> m_queued;
+    std::atomic<int> m_sleeping;
+    std::atomic<bool> m_terminating;
+
+    std::atomic<uint64_t> m_executed;
+    std::atomic<uint64_t> m_stolen;
+};
+
+#endif
@@ -354,6 +354,25 @@ uint32 CreatePIDFile(std::string const& filename)
     return (uint32)pid;
 }
 
+size_t GetProcessResidentMemory()
+{
+#ifdef __linux__
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+
+    unsigned long size = 0, resident = 0;
+    int const read = fscanf(statm, "%lu %lu", &size, &resident);
+    fclose(statm);
+    if (read != 2)
+        return 0;
+
+    return size_t(resident) * size_t(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
 size_t utf8length(std::string& utf8str)
 {
     try
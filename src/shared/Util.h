@@ -404,6 +404,8 @@ void vutf8printf(FILE* out, char const* str, va_list* ap);
 
 bool IsIPAddress(char const* ipaddress);
 uint32 CreatePIDFile(std::string const& filename);
+// Resident memory of the process in bytes, 0 when the platform does not tell
+size_t GetProcessResidentMemory();
 
 void hexEncodeByteArray(uint8* bytes, uint32 arrayLen, std::string& result);
 std::string ByteArrayToHexStr(uint8 const* bytes, uint32 length, bool reverse = false);
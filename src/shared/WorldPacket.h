@@ -24,6 +24,7 @@
 
 #include "Common.h"
 #include "ByteBuffer.h"
+#include <memory>
 
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
@@ -65,8 +66,20 @@ class WorldPacket : public ByteBuffer
         uint32 GetPacketTime() const { return m_recvdTime; }
         void FillPacketTime(uint32 t) { m_recvdTime = t; }
 
+        // Received packets are allocated one by one, keep them out of the heap too
+        static void* operator new(size_t size) { return PacketBufferPool::Allocate(size); }
+        static void operator delete(void* p, size_t size) { PacketBufferPool::Deallocate(p, size); }
+
     protected:
         uint16 m_opcode;
         uint32 m_recvdTime;
 };
+
+// Immutable packet sent to several sockets (broadcasts) without copying it
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
+inline SharedWorldPacket MakeSharedPacket(WorldPacket&& packet)
+{
+    return std::allocate_shared<WorldPacket>(PacketBufferAllocator<WorldPacket>(), std::move(packet));
+}
 #endif